@@ -0,0 +1,105 @@
+#ifndef BACKPORT__CPP11__CHAR_SET__HPP
+#define BACKPORT__CPP11__CHAR_SET__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <cstdint>
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Set of bytes, for searches for any of several characters.
+///
+/// Membership is a lookup in a 256 bit table, independent of the number of
+/// characters in the set, unlike `string_view::find_first_of`.
+///
+class char_set
+{
+public:
+	using size_type = std::size_t;
+
+public: // construction
+	char_set() noexcept = default;
+
+	explicit char_set(string_view chars) noexcept
+	{
+		for (const char c : chars)
+			insert(c);
+	}
+
+	explicit char_set(const char * chars) noexcept
+		: char_set(string_view{chars})
+	{
+	}
+
+public: // modifiers
+	void insert(char c) noexcept
+	{
+		const auto i = static_cast<unsigned char>(c);
+		bits_[i / 64u] |= std::uint64_t{1} << (i % 64u);
+	}
+
+	void erase(char c) noexcept
+	{
+		const auto i = static_cast<unsigned char>(c);
+		bits_[i / 64u] &= ~(std::uint64_t{1} << (i % 64u));
+	}
+
+public: // operations
+	bool contains(char c) const noexcept
+	{
+		const auto i = static_cast<unsigned char>(c);
+		return (bits_[i / 64u] >> (i % 64u)) & 1u;
+	}
+
+	/// Position of the first character of `s` contained in the set, starting at `pos`,
+	/// `string_view::npos` if there is none.
+	size_type find(string_view s, size_type pos = 0) const noexcept
+	{
+		for (; pos < s.size(); ++pos)
+			if (contains(s[pos]))
+				return pos;
+		return string_view::npos;
+	}
+
+	/// Position of the first character of `s` not contained in the set, starting at `pos`,
+	/// `string_view::npos` if there is none.
+	size_type find_not(string_view s, size_type pos = 0) const noexcept
+	{
+		for (; pos < s.size(); ++pos)
+			if (!contains(s[pos]))
+				return pos;
+		return string_view::npos;
+	}
+
+private:
+	std::uint64_t bits_[4] = {0u, 0u, 0u, 0u};
+};
+}
+}
+
+#endif
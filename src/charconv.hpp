@@ -0,0 +1,1216 @@
+#ifndef BACKPORT__CPP11__CHARCONV__HPP
+#define BACKPORT__CPP11__CHARCONV__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include "charconv_tables.hpp"
+#include <system_error>
+#include <type_traits>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Result of the parse functions, modelled after `std::from_chars_result` (C++17).
+///
+/// `ptr` points to the first character not consumed, `ec` is `std::errc{}` on success,
+/// `std::errc::invalid_argument` if there was no number (`ptr` is then the start of
+/// the input) and `std::errc::result_out_of_range` if the number does not fit (all
+/// of it consumed nonetheless).
+///
+struct parse_result {
+	const char * ptr;
+	std::errc ec;
+};
+
+namespace detail
+{
+/// Loads 8 bytes, the first one in the least significant byte.
+inline std::uint64_t load_le64(const char * p) noexcept
+{
+	std::uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	v = __builtin_bswap64(v);
+#endif
+	return v;
+}
+
+/// Checks if all bytes of `v` (loaded with `load_le64`) are decimal digits.
+inline bool is_eight_digits(std::uint64_t v) noexcept
+{
+	const std::uint64_t high = v & 0xf0f0f0f0f0f0f0f0u;
+	const std::uint64_t high_above_9 = ((v + 0x0606060606060606u) & 0xf0f0f0f0f0f0f0f0u) >> 4;
+	return (high | high_above_9) == 0x3333333333333333u;
+}
+
+/// Converts eight decimal digits (loaded with `load_le64`) with three multiplications.
+inline std::uint32_t parse_eight_digits(std::uint64_t v) noexcept
+{
+	v -= 0x3030303030303030u;
+	v = (v * 10u) + (v >> 8); // pairs of digits
+	v = (((v & 0x000000ff000000ffu) * (100u + (1000000u * (std::uint64_t{1} << 32))))
+			+ (((v >> 16) & 0x000000ff000000ffu) * (1u + (10000u * (std::uint64_t{1} << 32)))))
+		>> 32;
+	return static_cast<std::uint32_t>(v);
+}
+
+inline unsigned digit_value(char c) noexcept
+{
+	if ((c >= '0') && (c <= '9'))
+		return static_cast<unsigned>(c - '0');
+	if ((c >= 'a') && (c <= 'z'))
+		return static_cast<unsigned>(c - 'a' + 10);
+	if ((c >= 'A') && (c <= 'Z'))
+		return static_cast<unsigned>(c - 'A' + 10);
+	return 36u;
+}
+
+/// Parses the digits of an unsigned number, `overflow` is set if it exceeds 64 bits.
+inline const char * parse_digits(const char * p, const char * last, int base,
+	std::uint64_t & value, bool & overflow) noexcept
+{
+	std::uint64_t acc = 0u;
+	overflow = false;
+
+	if (base == 10) {
+		while ((p != last) && (*p == '0'))
+			++p;
+
+		// up to 19 digits always fit
+		const char * const first = p;
+		while ((last - p >= 8) && (p - first <= 11)) {
+			const std::uint64_t v = load_le64(p);
+			if (!is_eight_digits(v))
+				break;
+			acc = (acc * 100000000u) + parse_eight_digits(v);
+			p += 8;
+		}
+		for (; (p != last) && (p - first < 19); ++p) {
+			const unsigned d = static_cast<unsigned char>(*p - '0');
+			if (d > 9u)
+				break;
+			acc = (acc * 10u) + d;
+		}
+	}
+
+	const auto b = static_cast<unsigned>(base);
+	for (; p != last; ++p) {
+		const unsigned d = digit_value(*p);
+		if (d >= b)
+			break;
+		if (acc > (std::numeric_limits<std::uint64_t>::max() - d) / b)
+			overflow = true;
+		else
+			acc = (acc * b) + d;
+	}
+
+	value = acc;
+	return p;
+}
+}
+
+///
+/// Parses an integer at the beginning of the view, in the style of `std::from_chars`.
+///
+/// Accepts an optional minus sign for signed types followed by digits of the base
+/// (2 to 36, letters in either case). No whitespace, plus sign or prefix is accepted,
+/// no locale is involved and no memory allocated. Decimal numbers are converted
+/// eight digits at a time (SWAR). `out` is modified only on success.
+///
+template <class T> parse_result parse_int(string_view s, T & out, int base = 10) noexcept
+{
+	static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+		"integral type required");
+	static_assert(sizeof(T) <= sizeof(std::uint64_t), "at most 64 bits supported");
+	assert((base >= 2) && (base <= 36));
+
+	const char * const first = s.data();
+	const char * const last = first + s.size();
+	const char * p = first;
+
+	const bool negative = std::is_signed<T>::value && (p != last) && (*p == '-');
+	if (negative)
+		++p;
+
+	std::uint64_t value;
+	bool overflow;
+	const char * const digits = p;
+	p = detail::parse_digits(p, last, base, value, overflow);
+	if (p == digits)
+		return {first, std::errc::invalid_argument};
+
+	using U = typename std::make_unsigned<T>::type;
+	const std::uint64_t limit
+		= static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u);
+	if (overflow || (value > limit))
+		return {p, std::errc::result_out_of_range};
+
+	out = negative ? static_cast<T>(U(0) - static_cast<U>(value)) : static_cast<T>(value);
+	return {p, std::errc{}};
+}
+
+namespace detail
+{
+inline bool is_digit(char c) noexcept { return static_cast<unsigned char>(c - '0') <= 9u; }
+
+inline bool equal_ignore_case(const char * p, const char * last, const char * word) noexcept
+{
+	for (; *word; ++p, ++word)
+		if ((p == last) || ((*p | 0x20) != *word))
+			return false;
+	return true;
+}
+
+inline unsigned count_leading_zeros(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__)
+	return static_cast<unsigned>(__builtin_clzll(x));
+#else
+	unsigned n = 0u;
+	for (; !(x & (std::uint64_t{1} << 63)); x <<= 1)
+		++n;
+	return n;
+#endif
+}
+
+/// Returns the high 64 bits of the product, the low ones are stored in `low`.
+inline std::uint64_t multiply_high(
+	std::uint64_t a, std::uint64_t b, std::uint64_t & low) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 uint128;
+	const uint128 r = static_cast<uint128>(a) * b;
+	low = static_cast<std::uint64_t>(r);
+	return static_cast<std::uint64_t>(r >> 64);
+#else
+	const std::uint64_t a_lo = a & 0xffffffffu;
+	const std::uint64_t a_hi = a >> 32;
+	const std::uint64_t b_lo = b & 0xffffffffu;
+	const std::uint64_t b_hi = b >> 32;
+	const std::uint64_t lo_lo = a_lo * b_lo;
+	const std::uint64_t hi_lo = a_hi * b_lo;
+	const std::uint64_t lo_hi = a_lo * b_hi;
+	const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+	low = (cross << 32) | (lo_lo & 0xffffffffu);
+	return (hi_lo >> 32) + (cross >> 32) + (a_hi * b_hi);
+#endif
+}
+
+/// Properties of the IEEE 754 binary formats.
+template <class T> struct float_format;
+
+template <> struct float_format<double> {
+	using bits_type = std::uint64_t;
+
+	static constexpr int mantissa_bits() { return 52; }
+	static constexpr int minimum_exponent() { return -1023; }
+	static constexpr int infinite_power() { return 0x7ff; }
+	static constexpr int smallest_power_of_ten() { return -342; }
+	static constexpr int largest_power_of_ten() { return 308; }
+	static constexpr int min_fast_path_exponent() { return -22; }
+	static constexpr int max_fast_path_exponent() { return 22; }
+	static constexpr int min_round_to_even_exponent() { return -4; }
+	static constexpr int max_round_to_even_exponent() { return 23; }
+
+	static double exact_power_of_ten(int i) noexcept
+	{
+		static constexpr double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+			1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+		return powers[i];
+	}
+};
+
+template <> struct float_format<float> {
+	using bits_type = std::uint32_t;
+
+	static constexpr int mantissa_bits() { return 23; }
+	static constexpr int minimum_exponent() { return -127; }
+	static constexpr int infinite_power() { return 0xff; }
+	static constexpr int smallest_power_of_ten() { return -65; }
+	static constexpr int largest_power_of_ten() { return 38; }
+	static constexpr int min_fast_path_exponent() { return -10; }
+	static constexpr int max_fast_path_exponent() { return 10; }
+	static constexpr int min_round_to_even_exponent() { return -17; }
+	static constexpr int max_round_to_even_exponent() { return 10; }
+
+	static float exact_power_of_ten(int i) noexcept
+	{
+		static constexpr float powers[]
+			= {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+		return powers[i];
+	}
+};
+
+/// Binary mantissa (without the implicit bit) and biased exponent. A negative
+/// exponent signals that the result could not be determined.
+struct adjusted_mantissa {
+	std::uint64_t mantissa;
+	std::int32_t power2;
+
+	bool operator==(const adjusted_mantissa & other) const noexcept
+	{
+		return (mantissa == other.mantissa) && (power2 == other.power2);
+	}
+};
+
+/// A decimal number `mantissa * 10^exponent` as scanned from the input.
+struct decimal_number {
+	std::uint64_t mantissa;
+	std::int64_t exponent;
+	bool negative;
+	bool too_many_digits; // mantissa holds the first 19 significant digits only
+};
+
+/// Scans a decimal number in the `std::chars_format::general` syntax.
+///
+/// Returns the end of the number or `nullptr` if there is none.
+inline const char * scan_decimal(const char * p, const char * last, decimal_number & n) noexcept
+{
+	n.negative = (p != last) && (*p == '-');
+	if (n.negative)
+		++p;
+
+	std::uint64_t i = 0u; // wraps with too many digits, recomputed below
+	const char * const integer = p;
+	while ((last - p >= 8) && is_eight_digits(load_le64(p))) {
+		i = (i * 100000000u) + parse_eight_digits(load_le64(p));
+		p += 8;
+	}
+	for (; (p != last) && is_digit(*p); ++p)
+		i = (i * 10u) + static_cast<unsigned>(*p - '0');
+	const char * const integer_end = p;
+
+	const char * fraction = p;
+	const char * fraction_end = p;
+	if ((p != last) && (*p == '.')) {
+		fraction = ++p;
+		while ((last - p >= 8) && is_eight_digits(load_le64(p))) {
+			i = (i * 100000000u) + parse_eight_digits(load_le64(p));
+			p += 8;
+		}
+		for (; (p != last) && is_digit(*p); ++p)
+			i = (i * 10u) + static_cast<unsigned>(*p - '0');
+		fraction_end = p;
+	}
+
+	const std::int64_t digits = (integer_end - integer) + (fraction_end - fraction);
+	if (digits == 0)
+		return nullptr;
+
+	// an exponent without digits is not part of the number
+	std::int64_t explicit_exponent = 0;
+	if ((p != last) && ((*p == 'e') || (*p == 'E'))) {
+		const char * q = p + 1;
+		const bool negative_exponent = (q != last) && (*q == '-');
+		if ((q != last) && ((*q == '-') || (*q == '+')))
+			++q;
+		if ((q != last) && is_digit(*q)) {
+			for (; (q != last) && is_digit(*q); ++q)
+				if (explicit_exponent < 0x10000000)
+					explicit_exponent = (explicit_exponent * 10) + (*q - '0');
+			if (negative_exponent)
+				explicit_exponent = -explicit_exponent;
+			p = q;
+		}
+	}
+
+	n.mantissa = i;
+	n.exponent = explicit_exponent - (fraction_end - fraction);
+	n.too_many_digits = false;
+
+	if (digits > 19) {
+		// leading zeros are not significant
+		std::int64_t significant = digits;
+		for (const char * s = integer; (s != p) && ((*s == '0') || (*s == '.')); ++s)
+			significant -= (*s == '0') ? 1 : 0;
+
+		if (significant > 19) {
+			constexpr std::uint64_t min_19_digits = 1000000000000000000u;
+			n.too_many_digits = true;
+			i = 0u;
+			const char * s = integer;
+			for (; (i < min_19_digits) && (s != integer_end); ++s)
+				i = (i * 10u) + static_cast<unsigned>(*s - '0');
+			if (i >= min_19_digits) {
+				n.exponent = explicit_exponent + (integer_end - s);
+			} else {
+				for (s = fraction; (i < min_19_digits) && (s != fraction_end); ++s)
+					i = (i * 10u) + static_cast<unsigned>(*s - '0');
+				n.exponent = explicit_exponent - (s - fraction);
+			}
+			n.mantissa = i;
+		}
+	}
+
+	return p;
+}
+
+///
+/// Eisel-Lemire: computes `w * 10^q` with a 128 bit approximation of the power of
+/// five. Returns a negative exponent in the rare cases the approximation is not
+/// sufficient to decide the rounding.
+///
+/// See Daniel Lemire: "Number Parsing at a Gigabyte per Second", Software: Practice
+/// and Experience, 2021.
+///
+template <class T> adjusted_mantissa compute_float(std::int64_t q, std::uint64_t w) noexcept
+{
+	using format = float_format<T>;
+	using table = power_of_five_table<>;
+
+	if ((w == 0u) || (q < format::smallest_power_of_ten()))
+		return {0u, 0};
+	if (q > format::largest_power_of_ten())
+		return {0u, format::infinite_power()};
+
+	const unsigned lz = count_leading_zeros(w);
+	w <<= lz;
+
+	// enough bits for the mantissa, the implicit bit and the rounding
+	const std::size_t index = 2u * static_cast<std::size_t>(q - table::smallest_power);
+	std::uint64_t low;
+	std::uint64_t high = multiply_high(w, table::values[index], low);
+	constexpr std::uint64_t precision_mask = ~std::uint64_t{0} >> (format::mantissa_bits() + 3);
+	if ((high & precision_mask) == precision_mask) {
+		std::uint64_t second_low;
+		const std::uint64_t second_high
+			= multiply_high(w, table::values[index + 1u], second_low);
+		low += second_high;
+		if (second_high > low)
+			++high;
+	}
+
+	// the product may be too far off outside of the exactly representable powers
+	if ((low == ~std::uint64_t{0}) && ((q < -27) || (q > 55)))
+		return {0u, -1};
+
+	const int upper_bit = static_cast<int>(high >> 63);
+	const int shift = upper_bit + 64 - format::mantissa_bits() - 3;
+	std::uint64_t mantissa = high >> shift;
+	// floor(log2(10^q)) == floor(q * log2(10))
+	int power2 = static_cast<int>((((152170 + 65536) * q) >> 16) + 63) + upper_bit
+		- static_cast<int>(lz) - format::minimum_exponent();
+
+	if (power2 <= 0) { // subnormal
+		if (-power2 + 1 >= 64)
+			return {0u, 0};
+		mantissa >>= -power2 + 1;
+		mantissa += mantissa & 1u;
+		mantissa >>= 1;
+		// rounding may have produced the smallest normal number
+		power2 = (mantissa < (std::uint64_t{1} << format::mantissa_bits())) ? 0 : 1;
+		return {mantissa, power2};
+	}
+
+	// exactly halfway between two floats: round to even
+	if ((low <= 1u) && (q >= format::min_round_to_even_exponent())
+		&& (q <= format::max_round_to_even_exponent()) && ((mantissa & 3u) == 1u)
+		&& ((mantissa << shift) == high))
+		mantissa &= ~std::uint64_t{1};
+
+	mantissa += mantissa & 1u;
+	mantissa >>= 1;
+	if (mantissa >= (std::uint64_t{2} << format::mantissa_bits())) {
+		mantissa = std::uint64_t{1} << format::mantissa_bits();
+		++power2;
+	}
+	mantissa &= ~(std::uint64_t{1} << format::mantissa_bits());
+	if (power2 >= format::infinite_power())
+		return {0u, format::infinite_power()};
+	return {mantissa, static_cast<std::int32_t>(power2)};
+}
+
+///
+/// Arbitrary precision decimal `0.d[0]d[1]... * 10^point`, shifted by powers of two
+/// until it is in the range of the mantissa. Exact for any input, used when the
+/// Eisel-Lemire algorithm cannot decide.
+///
+/// See Nigel Tao: "The Simple Decimal Conversion algorithm", Wuffs.
+///
+class decimal_digits
+{
+public:
+	static constexpr std::uint32_t max_digits = 768u;
+	static constexpr std::int32_t point_range = 2047;
+
+	/// Reads a number accepted by `scan_decimal`, ending at `last`.
+	decimal_digits(const char * p, const char * last) noexcept
+	{
+		if (*p == '-')
+			++p;
+		while ((p != last) && (*p == '0'))
+			++p;
+		for (; (p != last) && is_digit(*p); ++p)
+			push(*p);
+		if ((p != last) && (*p == '.')) {
+			const char * const fraction = ++p;
+			if (count == 0u)
+				while ((p != last) && (*p == '0'))
+					++p;
+			for (; (p != last) && is_digit(*p); ++p)
+				push(*p);
+			point = static_cast<std::int32_t>(fraction - p);
+		}
+		if (count > 0u) {
+			// trailing zeros are not significant
+			std::uint32_t zeros = 0u;
+			for (const char * s = p - 1; (*s == '0') || (*s == '.'); --s)
+				zeros += (*s == '0') ? 1u : 0u;
+			point += static_cast<std::int32_t>(count);
+			count -= zeros;
+		}
+		if (count > max_digits) {
+			truncated = true;
+			count = max_digits;
+		}
+		if ((p != last) && ((*p == 'e') || (*p == 'E'))) {
+			++p;
+			const bool negative = *p == '-';
+			if ((*p == '-') || (*p == '+'))
+				++p;
+			std::int32_t e = 0;
+			for (; (p != last) && is_digit(*p); ++p)
+				if (e < 0x10000)
+					e = (e * 10) + (*p - '0');
+			point += negative ? -e : e;
+		}
+	}
+
+	template <class T> adjusted_mantissa to_binary() noexcept
+	{
+		using format = float_format<T>;
+
+		if ((count == 0u) || (point < -324))
+			return {0u, 0};
+		if (point >= 310)
+			return {0u, format::infinite_power()};
+
+		// shifts bringing the most significant digit into place, by number of digits
+		static constexpr std::uint8_t powers[]
+			= {0, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53, 56, 59};
+		constexpr std::uint32_t max_shift = 60u;
+		constexpr std::uint32_t num_powers = sizeof(powers) / sizeof(powers[0]);
+
+		std::int32_t exp2 = 0;
+		while (point > 0) {
+			const auto n = static_cast<std::uint32_t>(point);
+			const std::uint32_t shift = (n < num_powers) ? powers[n] : max_shift;
+			right_shift(shift);
+			if (point < -point_range)
+				return {0u, 0};
+			exp2 += static_cast<std::int32_t>(shift);
+		}
+		// into the range [1/2, 1)
+		while (point <= 0) {
+			std::uint32_t shift;
+			if (point == 0) {
+				if (digits[0] >= 5u)
+					break;
+				shift = (digits[0] < 2u) ? 2u : 1u;
+			} else {
+				const auto n = static_cast<std::uint32_t>(-point);
+				shift = (n < num_powers) ? powers[n] : max_shift;
+			}
+			left_shift(shift);
+			if (point > point_range)
+				return {0u, format::infinite_power()};
+			exp2 -= static_cast<std::int32_t>(shift);
+		}
+		// into the range [1, 2)
+		--exp2;
+
+		while (format::minimum_exponent() + 1 > exp2) {
+			auto n = static_cast<std::uint32_t>(format::minimum_exponent() + 1 - exp2);
+			if (n > max_shift)
+				n = max_shift;
+			right_shift(n);
+			exp2 += static_cast<std::int32_t>(n);
+		}
+		if (exp2 - format::minimum_exponent() >= format::infinite_power())
+			return {0u, format::infinite_power()};
+
+		const std::uint32_t bits = format::mantissa_bits() + 1;
+		left_shift(bits);
+		std::uint64_t mantissa = round();
+		if (mantissa >= (std::uint64_t{1} << bits)) {
+			right_shift(1u);
+			++exp2;
+			mantissa = round();
+			if (exp2 - format::minimum_exponent() >= format::infinite_power())
+				return {0u, format::infinite_power()};
+		}
+		std::int32_t power2 = exp2 - format::minimum_exponent();
+		if (mantissa < (std::uint64_t{1} << format::mantissa_bits()))
+			--power2;
+		return {mantissa & ((std::uint64_t{1} << format::mantissa_bits()) - 1u), power2};
+	}
+
+private:
+	void push(char c) noexcept
+	{
+		if (count < max_digits)
+			digits[count] = static_cast<std::uint8_t>(c - '0');
+		++count;
+	}
+
+	void trim() noexcept
+	{
+		while ((count > 0u) && (digits[count - 1u] == 0u))
+			--count;
+	}
+
+	/// Integer part, rounded to nearest, ties to even.
+	std::uint64_t round() const noexcept
+	{
+		if ((count == 0u) || (point < 0))
+			return 0u;
+		if (point > 18)
+			return ~std::uint64_t{0};
+		const auto n = static_cast<std::uint32_t>(point);
+		std::uint64_t value = 0u;
+		for (std::uint32_t i = 0u; i < n; ++i)
+			value = (value * 10u) + ((i < count) ? digits[i] : 0u);
+		bool up = false;
+		if (n < count) {
+			up = digits[n] >= 5u;
+			if ((digits[n] == 5u) && (n + 1u == count))
+				up = truncated || ((n > 0u) && (digits[n - 1u] & 1u));
+		}
+		return value + (up ? 1u : 0u);
+	}
+
+	/// Multiplies by `2^shift`, `shift` at most 60.
+	void left_shift(std::uint32_t shift) noexcept
+	{
+		if (count == 0u)
+			return;
+
+		// 2^60 adds at most 19 digits, written from the back
+		std::uint8_t buffer[max_digits + 19u];
+		std::uint32_t w = sizeof(buffer);
+		std::uint64_t n = 0u;
+		for (std::uint32_t r = count; r > 0u; --r) {
+			n += std::uint64_t{digits[r - 1u]} << shift;
+			buffer[--w] = static_cast<std::uint8_t>(n % 10u);
+			n /= 10u;
+		}
+		for (; n > 0u; n /= 10u)
+			buffer[--w] = static_cast<std::uint8_t>(n % 10u);
+
+		std::uint32_t n_digits = static_cast<std::uint32_t>(sizeof(buffer)) - w;
+		point += static_cast<std::int32_t>(n_digits - count);
+		if (n_digits > max_digits) {
+			for (std::uint32_t i = max_digits; i < n_digits; ++i)
+				truncated = truncated || (buffer[w + i] != 0u);
+			n_digits = max_digits;
+		}
+		std::memcpy(digits, buffer + w, n_digits);
+		count = n_digits;
+		trim();
+	}
+
+	/// Divides by `2^shift`, `shift` at most 60.
+	void right_shift(std::uint32_t shift) noexcept
+	{
+		std::uint32_t r = 0u;
+		std::uint32_t w = 0u;
+		std::uint64_t n = 0u;
+		while ((n >> shift) == 0u) {
+			if (r < count) {
+				n = (n * 10u) + digits[r++];
+			} else if (n == 0u) {
+				return;
+			} else {
+				while ((n >> shift) == 0u) {
+					n *= 10u;
+					++r;
+				}
+				break;
+			}
+		}
+		point -= static_cast<std::int32_t>(r) - 1;
+		if (point < -point_range) {
+			count = 0u;
+			point = 0;
+			truncated = false;
+			return;
+		}
+		const std::uint64_t mask = (std::uint64_t{1} << shift) - 1u;
+		while (r < count) {
+			const auto digit = static_cast<std::uint8_t>(n >> shift);
+			n = ((n & mask) * 10u) + digits[r++];
+			digits[w++] = digit;
+		}
+		for (; n > 0u; n = (n & mask) * 10u) {
+			const auto digit = static_cast<std::uint8_t>(n >> shift);
+			if (w < max_digits)
+				digits[w++] = digit;
+			else if (digit > 0u)
+				truncated = true;
+		}
+		count = w;
+		trim();
+	}
+
+private:
+	std::uint32_t count = 0u;
+	std::int32_t point = 0;
+	bool truncated = false;
+	std::uint8_t digits[max_digits];
+};
+
+template <class T> T to_float(bool negative, adjusted_mantissa am) noexcept
+{
+	using format = float_format<T>;
+	using bits_type = typename format::bits_type;
+
+	bits_type bits = static_cast<bits_type>(am.mantissa)
+		| (static_cast<bits_type>(am.power2) << format::mantissa_bits());
+	if (negative)
+		bits |= bits_type{1} << (sizeof(bits_type) * 8u - 1u);
+	T value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/// Parses `inf`, `infinity` and `nan` with an optional `(chars)` suffix, ignoring case.
+template <class T>
+const char * parse_special(const char * p, const char * last, T & out) noexcept
+{
+	const bool negative = (p != last) && (*p == '-');
+	if (negative)
+		++p;
+	if (equal_ignore_case(p, last, "nan")) {
+		p += 3;
+		if ((p != last) && (*p == '(')) {
+			const char * s = p + 1;
+			while ((s != last)
+				&& (is_digit(*s) || (((*s | 0x20) >= 'a') && ((*s | 0x20) <= 'z'))
+					|| (*s == '_')))
+				++s;
+			if ((s != last) && (*s == ')'))
+				p = s + 1;
+		}
+		out = negative ? -std::numeric_limits<T>::quiet_NaN()
+					   : std::numeric_limits<T>::quiet_NaN();
+		return p;
+	}
+	if (equal_ignore_case(p, last, "inf")) {
+		p += equal_ignore_case(p, last, "infinity") ? 8 : 3;
+		out = negative ? -std::numeric_limits<T>::infinity()
+					   : std::numeric_limits<T>::infinity();
+		return p;
+	}
+	return nullptr;
+}
+
+template <class T> parse_result parse_floating(string_view s, T & out) noexcept
+{
+	using format = float_format<T>;
+
+	const char * const first = s.data();
+	const char * const last = first + s.size();
+
+	decimal_number n;
+	const char * const end = scan_decimal(first, last, n);
+	if (!end) {
+		const char * const special = parse_special(first, last, out);
+		if (special)
+			return {special, std::errc{}};
+		return {first, std::errc::invalid_argument};
+	}
+
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+	// Clinger: mantissa and power of ten are exact, one correctly rounded operation
+	if ((n.exponent >= format::min_fast_path_exponent())
+		&& (n.exponent <= format::max_fast_path_exponent())
+		&& (n.mantissa <= (std::uint64_t{2} << format::mantissa_bits()))
+		&& !n.too_many_digits) {
+		T value = static_cast<T>(n.mantissa);
+		if (n.exponent < 0)
+			value = value / format::exact_power_of_ten(static_cast<int>(-n.exponent));
+		else
+			value = value * format::exact_power_of_ten(static_cast<int>(n.exponent));
+		out = n.negative ? -value : value;
+		return {end, std::errc{}};
+	}
+#endif
+
+	adjusted_mantissa am = compute_float<T>(n.exponent, n.mantissa);
+	// with truncated digits the result must not depend on the rest of them
+	if (n.too_many_digits && (am.power2 >= 0)
+		&& !(am == compute_float<T>(n.exponent, n.mantissa + 1u)))
+		am.power2 = -1;
+	if (am.power2 < 0)
+		am = decimal_digits{first, end}.to_binary<T>();
+
+	if (am.power2 == format::infinite_power())
+		return {end, std::errc::result_out_of_range};
+
+	out = to_float<T>(n.negative, am);
+	return {end, std::errc{}};
+}
+}
+
+///
+/// Parses a floating point number at the beginning of the view, in the style of
+/// `std::from_chars` with `std::chars_format::general`.
+///
+/// Accepts an optional minus sign, digits with an optional decimal point and an
+/// optional exponent, as well as `inf`, `infinity` and `nan`. The result is
+/// correctly rounded and identical to the one of `strtod`, but neither a terminating
+/// NUL, a locale nor memory is needed. Most numbers are converted with a single
+/// multiplication (Clinger) or a 128 bit product (Eisel-Lemire), an exact but
+/// slow conversion is used only for the remaining close cases.
+///
+/// Numbers which do not fit are reported as `result_out_of_range`, those too small
+/// are rounded to zero. `out` is modified only on success.
+///
+inline parse_result parse_double(string_view s, double & out) noexcept
+{
+	return detail::parse_floating(s, out);
+}
+
+/// Same as `parse_double` for single precision, as by `strtof`.
+inline parse_result parse_float(string_view s, float & out) noexcept
+{
+	return detail::parse_floating(s, out);
+}
+namespace detail
+{
+#if defined(__SSE2__)
+///
+/// Converts 1 to 16 decimal digits at once: the digits are right aligned within a
+/// vector padded with zeros, validated with one comparison and combined pairwise
+/// with multiply-adds. Returns false if any of the characters is not a digit.
+///
+inline bool parse_sixteen_digits(const char * p, std::size_t n, std::uint64_t & value) noexcept
+{
+	alignas(16) char buffer[16];
+	std::memset(buffer, '0', sizeof(buffer));
+	std::memcpy(buffer + sizeof(buffer) - n, p, n);
+
+	const __m128i x = _mm_sub_epi8(
+		_mm_load_si128(reinterpret_cast<const __m128i *>(buffer)), _mm_set1_epi8('0'));
+	const __m128i nine = _mm_set1_epi8(9);
+	const bool digits
+		= _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(x, nine), nine)) == 0xffff;
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i tens = _mm_set_epi16(1, 10, 1, 10, 1, 10, 1, 10);
+	__m128i v = _mm_packs_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(x, zero), tens),
+		_mm_madd_epi16(_mm_unpackhi_epi8(x, zero), tens)); // 8 x 2 digits
+	v = _mm_madd_epi16(v, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100)); // 4 x 4 digits
+	v = _mm_packs_epi32(v, v);
+	v = _mm_madd_epi16(v, _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000)); // 2 x 8
+	const auto high = static_cast<std::uint32_t>(_mm_cvtsi128_si32(v));
+	const auto low = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(v, 4)));
+
+	value = (std::uint64_t{high} * 100000000u) + low;
+	return digits;
+}
+#endif
+}
+
+///
+/// Parses a column of integers, each view has to contain exactly one number in the
+/// syntax of `parse_int`.
+///
+/// Bit `i % 8` of `ok[i / 8]` is set if `in[i]` was parsed, `ok` must provide
+/// `(n + 7) / 8` bytes. Failed entries are stored as zero. Returns the number of
+/// parsed values.
+///
+/// The views are converted one at a time. A view with an optional sign and up to 16
+/// digits is validated with one SSE2 comparison and converted with multiply-adds,
+/// one view per vector and without branches on its characters. The length of each
+/// view selects this path; longer views take the path of `parse_int`.
+///
+inline std::size_t parse_ints(
+	const string_view * in, std::size_t n, std::int64_t * out, std::uint8_t * ok) noexcept
+{
+	std::size_t parsed = 0u;
+	for (std::size_t i = 0u; i < n; i += 8u) {
+		const std::size_t count = std::min(n - i, std::size_t{8});
+		unsigned mask = 0u;
+		for (std::size_t k = 0u; k < count; ++k) {
+			const string_view s = in[i + k];
+			std::int64_t value = 0;
+			bool valid;
+#if defined(__SSE2__)
+			const std::size_t sign = ((s.size() > 0u) && (s[0] == '-')) ? 1u : 0u;
+			const std::size_t digits = s.size() - sign;
+			if (digits - 1u < 16u) {
+				std::uint64_t u;
+				valid = detail::parse_sixteen_digits(s.data() + sign, digits, u);
+				value = sign ? -static_cast<std::int64_t>(u) : static_cast<std::int64_t>(u);
+			} else
+#endif
+			{
+				const parse_result r = parse_int(s, value);
+				valid = (r.ec == std::errc{}) && (r.ptr == s.data() + s.size());
+			}
+			out[i + k] = valid ? value : 0;
+			mask |= static_cast<unsigned>(valid) << k;
+			parsed += valid ? 1u : 0u;
+		}
+		ok[i / 8u] = static_cast<std::uint8_t>(mask);
+	}
+	return parsed;
+}
+namespace detail
+{
+/// Writes the decimal digits of `v` backwards, ending before `last`, two at a time.
+inline char * write_digits(char * last, std::uint64_t v) noexcept
+{
+	static constexpr char pairs[] = "00010203040506070809"
+									"10111213141516171819"
+									"20212223242526272829"
+									"30313233343536373839"
+									"40414243444546474849"
+									"50515253545556575859"
+									"60616263646566676869"
+									"70717273747576777879"
+									"80818283848586878889"
+									"90919293949596979899";
+	while (v >= 100u) {
+		const auto i = static_cast<std::size_t>(v % 100u) * 2u;
+		v /= 100u;
+		*--last = pairs[i + 1u];
+		*--last = pairs[i];
+	}
+	if (v >= 10u) {
+		const auto i = static_cast<std::size_t>(v) * 2u;
+		*--last = pairs[i + 1u];
+		*--last = pairs[i];
+	} else {
+		*--last = static_cast<char>('0' + v);
+	}
+	return last;
+}
+
+template <class T> bool is_negative(T value, std::true_type) noexcept { return value < 0; }
+template <class T> bool is_negative(T, std::false_type) noexcept { return false; }
+
+/// A decimal number `significand * 10^exponent`.
+struct shortest_decimal {
+	std::uint64_t significand;
+	int exponent;
+};
+
+/// floor(e * log10(2)), with a correction for `3/4 * 2^e` if `three_quarters`.
+inline int floor_log10_pow2(int e, bool three_quarters) noexcept
+{
+	return (e * 1262611 - (three_quarters ? 524031 : 0)) >> 22;
+}
+
+/// floor(e * log2(10))
+inline int floor_log2_pow10(int e) noexcept { return (e * 1741647) >> 19; }
+
+/// `g * cp / 2^128`, rounded to odd, with the 128 bit power `g` of 10^k.
+inline std::uint64_t round_to_odd(int k, std::uint64_t cp) noexcept
+{
+	using table = power_of_ten_table<>;
+	const std::size_t index = 2u * static_cast<std::size_t>(k - table::smallest_power);
+	std::uint64_t low;
+	const std::uint64_t x = multiply_high(cp, table::values[index + 1u], low);
+	const std::uint64_t y_high = multiply_high(cp, table::values[index], low);
+	const std::uint64_t y_low = low + x;
+	const std::uint64_t y1 = y_high + ((y_low < x) ? 1u : 0u);
+	return y1 | ((y_low > 1u) ? 1u : 0u);
+}
+
+/// `g * cp / 2^64`, rounded to odd, with the power of 10^k rounded up to 64 bits.
+inline std::uint32_t round_to_odd(int k, std::uint32_t cp) noexcept
+{
+	using table = power_of_ten_table<>;
+	const std::size_t index = 2u * static_cast<std::size_t>(k - table::smallest_power);
+	const std::uint64_t g
+		= table::values[index] + ((table::values[index + 1u] != 0u) ? 1u : 0u);
+	std::uint64_t low;
+	const std::uint64_t high = multiply_high(g, cp, low);
+	const auto y1 = static_cast<std::uint32_t>(high);
+	const auto y0 = static_cast<std::uint32_t>(low >> 32);
+	return y1 | ((y0 > 1u) ? 1u : 0u);
+}
+
+///
+/// Schubfach: the shortest decimal within the rounding interval of a finite
+/// positive number, the closest one if there are several.
+///
+/// See Raffaello Giulietti: "The Schubfach way to render doubles", 2020.
+///
+template <class T> shortest_decimal to_shortest_decimal(T value) noexcept
+{
+	using format = float_format<T>;
+	using carrier = typename format::bits_type;
+	constexpr int mantissa_bits = format::mantissa_bits();
+	constexpr int bias = mantissa_bits - format::minimum_exponent();
+
+	carrier bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	const carrier significand = bits & ((carrier{1} << mantissa_bits) - 1u);
+	const int biased_exponent = static_cast<int>(bits >> mantissa_bits);
+
+	carrier c;
+	int q;
+	if (biased_exponent != 0) {
+		c = (carrier{1} << mantissa_bits) | significand;
+		q = biased_exponent - bias;
+		// small integers
+		if ((q <= 0) && (-q <= mantissa_bits) && ((c & ((carrier{1} << -q) - 1u)) == 0u))
+			return {static_cast<std::uint64_t>(c >> -q), 0};
+	} else {
+		c = significand;
+		q = 1 - bias;
+	}
+
+	const bool accept_bounds = (c % 2u) == 0u;
+	const bool lower_closer = (significand == 0u) && (biased_exponent > 1);
+
+	const carrier cbl = (4u * c) - 2u + (lower_closer ? 1u : 0u);
+	const carrier cb = 4u * c;
+	const carrier cbr = (4u * c) + 2u;
+
+	const int k = floor_log10_pow2(q, lower_closer);
+	const int h = q + floor_log2_pow10(-k) + 1;
+
+	const carrier vbl = round_to_odd(-k, static_cast<carrier>(cbl << h));
+	const carrier vb = round_to_odd(-k, static_cast<carrier>(cb << h));
+	const carrier vbr = round_to_odd(-k, static_cast<carrier>(cbr << h));
+
+	const carrier lower = vbl + (accept_bounds ? 0u : 1u);
+	const carrier upper = vbr - (accept_bounds ? 0u : 1u);
+
+	const carrier s = vb / 4u;
+	if (s >= 10u) {
+		// one digit less, at most one of the candidates is within the interval
+		const carrier sp = s / 10u;
+		const bool up_inside = lower <= 40u * sp;
+		const bool wp_inside = (40u * sp) + 40u <= upper;
+		if (up_inside != wp_inside)
+			return {std::uint64_t{sp} + (wp_inside ? 1u : 0u), k + 1};
+	}
+
+	const bool u_inside = lower <= 4u * s;
+	const bool w_inside = (4u * s) + 4u <= upper;
+	if (u_inside != w_inside)
+		return {std::uint64_t{s} + (w_inside ? 1u : 0u), k};
+
+	const carrier mid = (4u * s) + 2u;
+	const bool round_up = (vb > mid) || ((vb == mid) && ((s & 1u) != 0u));
+	return {std::uint64_t{s} + (round_up ? 1u : 0u), k};
+}
+
+///
+/// Writes the exact digits of a positive integral number into `p`. Numbers beyond 64
+/// bits are doubled in two limbs of 18 decimal digits each.
+///
+template <class T> char * write_integer(char * p, T value) noexcept
+{
+	using format = float_format<T>;
+	using carrier = typename format::bits_type;
+	constexpr int mantissa_bits = format::mantissa_bits();
+	constexpr int bias = mantissa_bits - format::minimum_exponent();
+	constexpr std::uint64_t limb = 1000000000000000000u;
+
+	carrier bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	const int e = static_cast<int>(bits >> mantissa_bits) - bias;
+	std::uint64_t low
+		= (carrier{1} << mantissa_bits) | (bits & ((carrier{1} << mantissa_bits) - 1u));
+	std::uint64_t high = 0u;
+	if (e <= 0) {
+		low >>= -e; // no fraction, the value is integral
+	} else {
+		for (int i = 0; i < e; ++i) {
+			high *= 2u;
+			low *= 2u;
+			if (low >= limb) {
+				low -= limb;
+				++high;
+			}
+		}
+	}
+
+	char digits[40];
+	char * const last = digits + sizeof(digits);
+	char * f;
+	if (high) {
+		f = write_digits(last, low);
+		while (f != last - 18)
+			*--f = '0';
+		f = write_digits(f, high);
+	} else {
+		f = write_digits(last, low);
+	}
+	std::memcpy(p, f, static_cast<std::size_t>(last - f));
+	return p + (last - f);
+}
+
+/// Writes the shortest representation, fixed or scientific, of a number into `p`.
+///
+/// Fixed notation is used if it is not longer than the scientific one. Integral
+/// numbers are then written with their exact digits, as by `std::to_chars`.
+template <class T> char * format_floating(char * p, T value) noexcept
+{
+	if (value != value) {
+		std::memcpy(p, "nan", 3u);
+		return p + 3;
+	}
+	if (std::signbit(value)) {
+		*p++ = '-';
+		value = -value;
+	}
+	if (value == std::numeric_limits<T>::infinity()) {
+		std::memcpy(p, "inf", 3u);
+		return p + 3;
+	}
+	if (value == T(0)) {
+		*p++ = '0';
+		return p;
+	}
+
+	shortest_decimal d = to_shortest_decimal(value);
+	while ((d.significand % 10u) == 0u) {
+		d.significand /= 10u;
+		++d.exponent;
+	}
+
+	char digits[20];
+	const char * const first = write_digits(digits + sizeof(digits), d.significand);
+	const int n = static_cast<int>(digits + sizeof(digits) - first);
+
+	// the shorter of both forms, fixed if equal (as std::to_chars)
+	const int scientific_exponent = d.exponent + n - 1;
+	const int abs_exponent = std::abs(scientific_exponent);
+	const int scientific_size
+		= n + ((n > 1) ? 1 : 0) + 2 + ((abs_exponent >= 100) ? 3 : 2);
+	int fixed_size;
+	if (d.exponent >= 0)
+		fixed_size = n + d.exponent;
+	else if (n + d.exponent > 0)
+		fixed_size = n + 1;
+	else
+		fixed_size = 2 - d.exponent;
+
+	if (fixed_size <= scientific_size) {
+		if (d.exponent >= 0)
+			return write_integer(p, value);
+		const int integer = n + d.exponent;
+		if (integer > 0) {
+			std::memcpy(p, first, static_cast<std::size_t>(integer));
+			p += integer;
+			*p++ = '.';
+			std::memcpy(p, first + integer, static_cast<std::size_t>(n - integer));
+			return p + (n - integer);
+		}
+		*p++ = '0';
+		*p++ = '.';
+		std::memset(p, '0', static_cast<std::size_t>(-integer));
+		p += -integer;
+		std::memcpy(p, first, static_cast<std::size_t>(n));
+		return p + n;
+	}
+
+	*p++ = first[0];
+	if (n > 1) {
+		*p++ = '.';
+		std::memcpy(p, first + 1, static_cast<std::size_t>(n - 1));
+		p += n - 1;
+	}
+	*p++ = 'e';
+	*p++ = (scientific_exponent < 0) ? '-' : '+';
+	if (abs_exponent < 10)
+		*p++ = '0';
+	char exponent[3];
+	const char * const e
+		= write_digits(exponent + sizeof(exponent), static_cast<std::uint64_t>(abs_exponent));
+	std::memcpy(p, e, static_cast<std::size_t>(exponent + sizeof(exponent) - e));
+	return p + (exponent + sizeof(exponent) - e);
+}
+}
+
+///
+/// Formats an integer into the specified buffer, as `std::to_chars` (C++17) in
+/// base 10. Returns a view to the characters within the buffer, which are not
+/// terminated. Digits are written two at a time from a table.
+///
+template <class T, std::size_t N> string_view format_int(char (&buf)[N], T value) noexcept
+{
+	static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+		"integral type required");
+	static_assert(sizeof(T) <= sizeof(std::uint64_t), "at most 64 bits supported");
+	static_assert(N >= std::numeric_limits<T>::digits10 + 2, "buffer too small");
+
+	using U = typename std::make_unsigned<T>::type;
+	const bool negative = detail::is_negative(value, std::is_signed<T>{});
+	const U u = negative ? static_cast<U>(U(0) - static_cast<U>(value)) : static_cast<U>(value);
+
+	char * p = detail::write_digits(buf + N, std::uint64_t{u});
+	if (negative)
+		*--p = '-';
+	return string_view{p, static_cast<std::size_t>(buf + N - p)};
+}
+
+///
+/// Formats a double into the specified buffer with the fewest digits which parse
+/// back to the same value, as `std::to_chars` (C++17) without a format: fixed or
+/// scientific, whichever is shorter. Integral numbers in fixed notation are written
+/// with their exact digits (`1494816201077134336`, not `1494816201077134300`).
+/// Infinity and NaN are written as `inf` and `nan`.
+///
+/// The digits are determined with the Schubfach algorithm, a few 128 bit
+/// multiplications and no loop over digits. Returns a view to the characters
+/// within the buffer, which are not terminated.
+///
+template <std::size_t N> string_view format_double(char (&buf)[N], double value) noexcept
+{
+	static_assert(N >= 24, "buffer too small");
+	return string_view{
+		buf, static_cast<std::size_t>(detail::format_floating(buf, value) - buf)};
+}
+
+/// Same as `format_double` for single precision.
+template <std::size_t N> string_view format_float(char (&buf)[N], float value) noexcept
+{
+	static_assert(N >= 15, "buffer too small");
+	return string_view{
+		buf, static_cast<std::size_t>(detail::format_floating(buf, value) - buf)};
+}
+}
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef BACKPORT__CPP11__CONCAT__HPP
+#define BACKPORT__CPP11__CONCAT__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <initializer_list>
+#include <iterator>
+
+namespace backport
+{
+namespace cpp11
+{
+namespace detail
+{
+template <class CharT, class Traits, class Allocator>
+void append_all(std::basic_string<CharT, Traits, Allocator> & s,
+	std::initializer_list<basic_string_view<CharT, Traits>> views)
+{
+	std::size_t size = s.size();
+	for (const auto & v : views)
+		size += v.size();
+	s.reserve(size);
+	for (const auto & v : views)
+		s.append(v.data(), v.size());
+}
+}
+
+///
+/// Concatenates views, and everything convertible to them, into a new string.
+///
+/// The total size is computed first, the string is allocated once and the views
+/// are copied into it.
+///
+///    auto key = concat(prefix, "/", name);
+///
+template <class CharT = char, class Traits = std::char_traits<CharT>, class... Views>
+std::basic_string<CharT, Traits> concat(const Views &... views)
+{
+	std::basic_string<CharT, Traits> s;
+	detail::append_all(s, {basic_string_view<CharT, Traits>(views)...});
+	return s;
+}
+
+///
+/// Appends the elements of the range to `s`, separated by `separator`, with at
+/// most one reallocation of `s`.
+///
+/// The elements have to be convertible to views, the range is traversed twice
+/// (size, then copy) and therefore has to be a forward range.
+///
+template <class CharT, class Traits, class Allocator, class Range>
+std::basic_string<CharT, Traits, Allocator> & append_join(
+	std::basic_string<CharT, Traits, Allocator> & s, const Range & range,
+	detail::non_deduced_view<CharT, Traits> separator)
+{
+	using std::begin;
+	using std::end;
+	using view_type = basic_string_view<CharT, Traits>;
+
+	std::size_t size = 0u;
+	std::size_t count = 0u;
+	for (auto i = begin(range); i != end(range); ++i, ++count)
+		size += view_type(*i).size();
+	if (count == 0u)
+		return s;
+	s.reserve(s.size() + size + ((count - 1u) * separator.size()));
+
+	bool first = true;
+	for (auto i = begin(range); i != end(range); ++i) {
+		if (!first)
+			s.append(separator.data(), separator.size());
+		first = false;
+		const view_type v(*i);
+		s.append(v.data(), v.size());
+	}
+	return s;
+}
+
+///
+/// Joins the elements of the range, separated by `separator`, into a new string
+/// allocated once. See `append_join`.
+///
+template <class CharT = char, class Traits = std::char_traits<CharT>, class Range>
+std::basic_string<CharT, Traits> join(
+	const Range & range, detail::non_deduced_view<CharT, Traits> separator)
+{
+	std::basic_string<CharT, Traits> s;
+	append_join(s, range, separator);
+	return s;
+}
+}
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef BACKPORT__CPP11__CSV_READER__HPP
+#define BACKPORT__CPP11__CSV_READER__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include "string_arena.hpp"
+#include "structural_index.hpp"
+#include <vector>
+
+namespace backport
+{
+namespace cpp11
+{
+namespace detail
+{
+/// Bit `i` is the parity of the bits `0..i` of `x`.
+inline std::uint64_t prefix_xor(std::uint64_t x) noexcept
+{
+	x ^= x << 1;
+	x ^= x << 2;
+	x ^= x << 4;
+	x ^= x << 8;
+	x ^= x << 16;
+	x ^= x << 32;
+	return x;
+}
+}
+
+///
+/// Reader of CSV data (RFC 4180), providing the fields of each record as views.
+///
+/// The data is scanned in blocks of 64 bytes: masks of quotes, delimiters and
+/// newlines are computed for a whole block (SSE2 where available), the prefix XOR
+/// of the quote mask marks the bytes within quoted fields. The remaining
+/// delimiters and newlines separate the fields.
+///
+/// Unquoted and quoted fields are views into the data. Only fields containing
+/// escaped (doubled) quotes are unescaped, into an arena owned by the reader.
+/// These stay valid until the arena is reset or the reader destroyed.
+///
+/// Records end with `\n` or `\r\n`. Malformed quoting is tolerated, such fields
+/// are returned as they are.
+///
+class csv_reader
+{
+public:
+	using size_type = std::size_t;
+
+public: // construction
+	explicit csv_reader(string_view data, char delimiter = ',', char quote = '"')
+		: data_(data)
+		, delimiter_(delimiter)
+		, quote_(quote)
+	{
+	}
+
+public: // access
+	/// Storage of unescaped fields.
+	string_arena & arena() noexcept { return arena_; }
+
+	/// Number of records read so far.
+	size_type records() const noexcept { return records_; }
+
+public: // operations
+	/// Reads the next record, replaces the content of `fields` by its fields.
+	///
+	/// Returns `false` if there are no more records.
+	bool next(std::vector<string_view> & fields)
+	{
+		fields.clear();
+		if (pos_ >= data_.size())
+			return false;
+
+		for (;;) {
+			const size_type end = next_separator();
+			const bool last = (end == data_.size()) || (data_[end] == '\n');
+			fields.push_back(field(data_.substr(pos_, end - pos_), last));
+			pos_ = end + 1u;
+			if (last) {
+				++records_;
+				return true;
+			}
+		}
+	}
+
+private:
+	/// Position of the next delimiter or newline outside of quotes, end of data if none.
+	size_type next_separator()
+	{
+		for (;;) {
+			if (mask_) {
+				const size_type i = block_ + detail::count_trailing_zeros(mask_);
+				mask_ &= mask_ - 1u;
+				return i;
+			}
+			block_ = started_ ? (block_ + 64u) : 0u;
+			started_ = true;
+			if (block_ >= data_.size()) {
+				block_ = data_.size();
+				return data_.size();
+			}
+			mask_ = block_mask();
+		}
+	}
+
+	std::uint64_t block_mask() noexcept
+	{
+		const char * p = data_.data() + block_;
+		std::uint64_t valid = ~std::uint64_t{0};
+		char tail[64] = {};
+		if (data_.size() - block_ < 64u) {
+			// the final block is copied, the bits of the padding are ignored
+			const size_type n = data_.size() - block_;
+			std::char_traits<char>::copy(tail, p, n);
+			valid = (std::uint64_t{1} << n) - 1u;
+			p = tail;
+		}
+
+		const std::uint64_t quotes = detail::equal_mask64(p, quote_) & valid;
+		const std::uint64_t separators
+			= (detail::equal_mask64(p, delimiter_) | detail::equal_mask64(p, '\n')) & valid;
+		const std::uint64_t quoted = detail::prefix_xor(quotes) ^ in_quotes_;
+		in_quotes_ = static_cast<std::uint64_t>(static_cast<std::int64_t>(quoted) >> 63);
+		return separators & ~quoted;
+	}
+
+	string_view field(string_view raw, bool last)
+	{
+		if (last && raw.size() && (raw.back() == '\r'))
+			raw.remove_suffix(1u);
+		if ((raw.size() < 2u) || (raw.front() != quote_) || (raw.back() != quote_))
+			return raw;
+
+		raw = raw.substr(1u, raw.size() - 2u);
+		size_type q = raw.find(quote_);
+		if (q == string_view::npos)
+			return raw;
+
+		// unescape doubled quotes
+		char * const result = arena_.allocate(raw.size());
+		char * out = result;
+		for (; q != string_view::npos; q = raw.find(quote_)) {
+			std::char_traits<char>::copy(out, raw.data(), q + 1u);
+			out += q + 1u;
+			raw.remove_prefix(std::min(q + 2u, raw.size()));
+		}
+		std::char_traits<char>::copy(out, raw.data(), raw.size());
+		out += raw.size();
+		return string_view{result, static_cast<size_type>(out - result)};
+	}
+
+private:
+	string_view data_;
+	char delimiter_;
+	char quote_;
+	string_arena arena_;
+	size_type pos_ = 0u; // start of the next field
+	size_type block_ = 0u; // start of the block of the mask
+	std::uint64_t mask_ = 0u; // unconsumed separators within the block
+	std::uint64_t in_quotes_ = 0u; // all bits set if the block starts within quotes
+	bool started_ = false;
+	size_type records_ = 0u;
+};
+}
+}
+
+#endif
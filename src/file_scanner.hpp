@@ -0,0 +1,553 @@
+#ifndef BACKPORT__CPP11__FILE_SCANNER__HPP
+#define BACKPORT__CPP11__FILE_SCANNER__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) \
+	&& defined(__NR_io_uring_register)
+#define BACKPORT_FILE_SCANNER_IO_URING
+#endif
+#endif
+#endif
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Reads files block by block and hands each block as view to a callback.
+///
+/// On Linux, reads are issued in batches through `io_uring` (raw system calls,
+/// no liburing), up to `queue_depth` of them in flight, into buffers registered
+/// with the kernel. If `io_uring` is not available, `queue_depth` threads (at most
+/// 16) read the files with `pread`.
+///
+/// Blocks are delivered in completion order, not necessarily in file order. The
+/// calls of the callback are serialized, the view is valid during the call only.
+/// Errors are reported by throwing `std::system_error`, exceptions thrown by the
+/// callback abort the scan and are propagated.
+///
+/// POSIX only.
+///
+class file_scanner
+{
+public:
+	using size_type = std::size_t;
+
+	struct block {
+		size_type file; ///< index of the file within the scanned paths
+		std::uint64_t offset; ///< position of the block within the file
+		string_view data;
+	};
+
+	enum class engine { automatic, io_uring, pread };
+
+public: // constants
+	static constexpr size_type default_block_size = 1024u * 1024u;
+	static constexpr unsigned default_queue_depth = 32u;
+	static constexpr unsigned max_threads = 16u;
+
+public: // construction
+	explicit file_scanner(size_type block_size = default_block_size,
+		unsigned queue_depth = default_queue_depth, engine e = engine::automatic)
+		: block_size_(std::max(block_size, size_type{1}))
+		, queue_depth_(std::max(queue_depth, 1u))
+	{
+#if defined(BACKPORT_FILE_SCANNER_IO_URING)
+		if (e != engine::pread) {
+			try {
+				ring_.reset(new ring{queue_depth_, block_size_});
+			} catch (const std::system_error &) {
+				if (e == engine::io_uring)
+					throw;
+			}
+		}
+#else
+		if (e == engine::io_uring)
+			throw std::system_error{ENOSYS, std::system_category(), "io_uring"};
+#endif
+	}
+
+public: // access
+	bool uses_io_uring() const noexcept
+	{
+#if defined(BACKPORT_FILE_SCANNER_IO_URING)
+		return ring_ != nullptr;
+#else
+		return false;
+#endif
+	}
+
+	size_type block_size() const noexcept { return block_size_; }
+
+public: // operations
+	/// Reads all files, calls `callback(const block &)` for every block read.
+	template <class Callback>
+	void scan(const std::vector<std::string> & paths, Callback callback)
+	{
+		work_queue queue{paths, block_size_};
+#if defined(BACKPORT_FILE_SCANNER_IO_URING)
+		if (ring_) {
+			scan_io_uring(queue, callback);
+			return;
+		}
+#endif
+		scan_pread(queue, callback);
+	}
+
+private:
+	/// Splits the files into read requests, opens and closes files on the way.
+	class work_queue
+	{
+	public:
+		struct request {
+			size_type file;
+			int fd;
+			std::uint64_t offset;
+			size_type length;
+		};
+
+		work_queue(const std::vector<std::string> & paths, size_type block_size)
+			: paths_(paths)
+			, block_size_(block_size)
+			, files_(paths.size())
+		{
+		}
+
+		work_queue(const work_queue &) = delete;
+		work_queue & operator=(const work_queue &) = delete;
+
+		~work_queue()
+		{
+			for (const auto & f : files_)
+				if (f.fd >= 0)
+					::close(f.fd);
+		}
+
+		/// Provides the next request, returns `false` if there is nothing left to read.
+		bool next(request & r)
+		{
+			if (!retries_.empty()) {
+				r = retries_.back();
+				retries_.pop_back();
+				return true;
+			}
+			while (current_ < files_.size()) {
+				file & f = files_[current_];
+				if (!f.opened)
+					open(f, paths_[current_]);
+				if (offset_ < f.size) {
+					const auto n = std::min<std::uint64_t>(block_size_, f.size - offset_);
+					r = request{current_, f.fd, offset_, static_cast<size_type>(n)};
+					offset_ += n;
+					++f.outstanding;
+					return true;
+				}
+				f.issued = true;
+				close_if_done(f);
+				++current_;
+				offset_ = 0u;
+			}
+			return false;
+		}
+
+		/// Schedules the unread remainder of a request again.
+		void retry(const request & r) { retries_.push_back(r); }
+
+		/// Marks a request as completely read.
+		void done(const request & r)
+		{
+			file & f = files_[r.file];
+			--f.outstanding;
+			close_if_done(f);
+		}
+
+	private:
+		struct file {
+			int fd = -1;
+			std::uint64_t size = 0u;
+			size_type outstanding = 0u;
+			bool opened = false;
+			bool issued = false;
+		};
+
+		static void open(file & f, const std::string & path)
+		{
+			f.fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (f.fd < 0)
+				throw std::system_error{errno, std::system_category(), "open"};
+			f.opened = true;
+			struct stat st;
+			if (::fstat(f.fd, &st) < 0)
+				throw std::system_error{errno, std::system_category(), "fstat"};
+			f.size = static_cast<std::uint64_t>(st.st_size);
+		}
+
+		static void close_if_done(file & f)
+		{
+			if (f.issued && (f.outstanding == 0u) && (f.fd >= 0)) {
+				::close(f.fd);
+				f.fd = -1;
+			}
+		}
+
+	private:
+		const std::vector<std::string> & paths_;
+		size_type block_size_;
+		std::vector<file> files_;
+		std::vector<request> retries_;
+		size_type current_ = 0u;
+		std::uint64_t offset_ = 0u;
+	};
+
+	template <class Callback> void scan_pread(work_queue & queue, Callback & callback)
+	{
+		std::mutex mtx;
+		std::exception_ptr error;
+		bool stop = false;
+
+		auto worker = [&]() {
+			std::unique_ptr<char[]> buffer{new char[block_size_]};
+			try {
+				for (;;) {
+					typename work_queue::request r;
+					{
+						std::lock_guard<std::mutex> lock{mtx};
+						if (stop || !queue.next(r))
+							return;
+					}
+
+					ssize_t n;
+					do {
+						n = ::pread(r.fd, buffer.get(), r.length, static_cast<off_t>(r.offset));
+					} while ((n < 0) && (errno == EINTR));
+					if (n < 0)
+						throw std::system_error{errno, std::system_category(), "pread"};
+
+					std::lock_guard<std::mutex> lock{mtx};
+					if (stop)
+						return;
+					const size_type size = static_cast<size_type>(n);
+					if (size)
+						callback(block{r.file, r.offset, string_view{buffer.get(), size}});
+					if (size && (size < r.length)) {
+						r.offset += size;
+						r.length -= size;
+						queue.retry(r);
+					} else {
+						queue.done(r); // end of file reached early if nothing was read
+					}
+				}
+			} catch (...) {
+				std::lock_guard<std::mutex> lock{mtx};
+				if (!error)
+					error = std::current_exception();
+				stop = true;
+			}
+		};
+
+		std::vector<std::thread> threads;
+		const unsigned n = std::min(queue_depth_, unsigned{max_threads});
+		for (unsigned i = 0u; i < n; ++i)
+			threads.emplace_back(worker);
+		for (auto & t : threads)
+			t.join();
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+#if defined(BACKPORT_FILE_SCANNER_IO_URING)
+	/// Submission and completion queues of `io_uring`, with the read buffers.
+	class ring
+	{
+	public:
+		ring(unsigned depth, size_type block_size)
+			: depth_(depth)
+			, block_size_(block_size)
+		{
+			::io_uring_params params;
+			std::memset(&params, 0, sizeof(params));
+			fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, depth, &params));
+			if (fd_ < 0)
+				throw std::system_error{errno, std::system_category(), "io_uring_setup"};
+			try {
+				map(params);
+				allocate_buffers();
+			} catch (...) {
+				unmap();
+				::close(fd_);
+				throw;
+			}
+		}
+
+		ring(const ring &) = delete;
+		ring & operator=(const ring &) = delete;
+
+		~ring()
+		{
+			unmap();
+			::close(fd_);
+			::free(buffers_);
+		}
+
+		unsigned depth() const noexcept { return depth_; }
+
+		char * buffer(unsigned slot) const noexcept { return buffers_ + slot * block_size_; }
+
+		/// Queues a read into the buffer of the slot, submitted by `submit`.
+		void prepare(unsigned slot, int fd, std::uint64_t offset, size_type length) noexcept
+		{
+			const unsigned tail = *sq_tail_;
+			const unsigned index = tail & *sq_mask_;
+			::io_uring_sqe & sqe = sqes_[index];
+			std::memset(&sqe, 0, sizeof(sqe));
+			sqe.opcode = fixed_ ? IORING_OP_READ_FIXED : IORING_OP_READ;
+			sqe.fd = fd;
+			sqe.off = offset;
+			sqe.addr = reinterpret_cast<std::uintptr_t>(buffer(slot));
+			sqe.len = static_cast<std::uint32_t>(length);
+			if (fixed_)
+				sqe.buf_index = static_cast<std::uint16_t>(slot);
+			sqe.user_data = slot;
+			sq_array_[index] = index;
+			__atomic_store_n(sq_tail_, tail + 1u, __ATOMIC_RELEASE);
+			++pending_;
+		}
+
+		/// Submits prepared reads, waits for at least `min_complete` completions.
+		void submit(unsigned min_complete)
+		{
+			const unsigned flags = min_complete ? IORING_ENTER_GETEVENTS : 0u;
+			for (;;) {
+				const long n = ::syscall(
+					__NR_io_uring_enter, fd_, pending_, min_complete, flags, nullptr, 0);
+				if (n >= 0) {
+					pending_ -= static_cast<unsigned>(n);
+					if (!pending_ || !min_complete)
+						return;
+				} else if (errno != EINTR) {
+					throw std::system_error{errno, std::system_category(), "io_uring_enter"};
+				}
+			}
+		}
+
+		/// Consumes one completion, returns `false` if none is available.
+		bool complete(unsigned & slot, int & result) noexcept
+		{
+			const unsigned head = *cq_head_;
+			if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))
+				return false;
+			const ::io_uring_cqe & cqe = cqes_[head & *cq_mask_];
+			slot = static_cast<unsigned>(cqe.user_data);
+			result = cqe.res;
+			__atomic_store_n(cq_head_, head + 1u, __ATOMIC_RELEASE);
+			return true;
+		}
+
+	private:
+		template <class T> static T * at(void * base, std::uint32_t offset) noexcept
+		{
+			return reinterpret_cast<T *>(static_cast<char *>(base) + offset);
+		}
+
+		void map(const ::io_uring_params & p)
+		{
+			sq_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+			cq_size_ = p.cq_off.cqes + p.cq_entries * sizeof(::io_uring_cqe);
+			const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+			if (single)
+				sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+
+			sq_ptr_ = map_region(sq_size_, IORING_OFF_SQ_RING);
+			cq_ptr_ = single ? sq_ptr_ : map_region(cq_size_, IORING_OFF_CQ_RING);
+			sqes_size_ = p.sq_entries * sizeof(::io_uring_sqe);
+			sqes_ = static_cast<::io_uring_sqe *>(map_region(sqes_size_, IORING_OFF_SQES));
+
+			sq_tail_ = at<unsigned>(sq_ptr_, p.sq_off.tail);
+			sq_mask_ = at<unsigned>(sq_ptr_, p.sq_off.ring_mask);
+			sq_array_ = at<unsigned>(sq_ptr_, p.sq_off.array);
+			cq_head_ = at<unsigned>(cq_ptr_, p.cq_off.head);
+			cq_tail_ = at<unsigned>(cq_ptr_, p.cq_off.tail);
+			cq_mask_ = at<unsigned>(cq_ptr_, p.cq_off.ring_mask);
+			cqes_ = at<::io_uring_cqe>(cq_ptr_, p.cq_off.cqes);
+		}
+
+		void * map_region(size_type size, std::uint64_t offset)
+		{
+			void * p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+				fd_, static_cast<off_t>(offset));
+			if (p == MAP_FAILED)
+				throw std::system_error{errno, std::system_category(), "mmap"};
+			return p;
+		}
+
+		void unmap() noexcept
+		{
+			if (sqes_)
+				::munmap(sqes_, sqes_size_);
+			if (cq_ptr_ && (cq_ptr_ != sq_ptr_))
+				::munmap(cq_ptr_, cq_size_);
+			if (sq_ptr_)
+				::munmap(sq_ptr_, sq_size_);
+		}
+
+		void allocate_buffers()
+		{
+			void * p = nullptr;
+			const int rc = ::posix_memalign(&p, 4096u, depth_ * block_size_);
+			if (rc != 0)
+				throw std::system_error{rc, std::system_category(), "posix_memalign"};
+			buffers_ = static_cast<char *>(p);
+
+			// registered buffers spare the kernel mapping them for every read,
+			// but are limited by RLIMIT_MEMLOCK, plain reads work without
+			std::vector<::iovec> iov(depth_);
+			for (unsigned i = 0u; i < depth_; ++i)
+				iov[i] = ::iovec{buffer(i), block_size_};
+			const long rc_register = ::syscall(
+				__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, iov.data(), depth_);
+			fixed_ = (rc_register == 0);
+		}
+
+	private:
+		unsigned depth_;
+		size_type block_size_;
+		int fd_ = -1;
+		unsigned pending_ = 0u;
+		bool fixed_ = false;
+		char * buffers_ = nullptr;
+
+		void * sq_ptr_ = nullptr;
+		void * cq_ptr_ = nullptr;
+		size_type sq_size_ = 0u;
+		size_type cq_size_ = 0u;
+		size_type sqes_size_ = 0u;
+		::io_uring_sqe * sqes_ = nullptr;
+		::io_uring_cqe * cqes_ = nullptr;
+		unsigned * sq_tail_ = nullptr;
+		unsigned * sq_mask_ = nullptr;
+		unsigned * sq_array_ = nullptr;
+		unsigned * cq_head_ = nullptr;
+		unsigned * cq_tail_ = nullptr;
+		unsigned * cq_mask_ = nullptr;
+	};
+
+	template <class Callback> void scan_io_uring(work_queue & queue, Callback & callback)
+	{
+		std::vector<typename work_queue::request> requests(ring_->depth());
+		std::vector<unsigned> free_slots;
+		for (unsigned i = ring_->depth(); i > 0u; --i)
+			free_slots.push_back(i - 1u);
+		unsigned active = 0u;
+
+		try {
+			for (;;) {
+				typename work_queue::request r;
+				while (!free_slots.empty() && queue.next(r)) {
+					const unsigned slot = free_slots.back();
+					free_slots.pop_back();
+					requests[slot] = r;
+					ring_->prepare(slot, r.fd, r.offset, r.length);
+					++active;
+				}
+				if (active == 0u)
+					break;
+
+				ring_->submit(1u);
+				unsigned slot;
+				int result;
+				while (ring_->complete(slot, result)) {
+					--active;
+					free_slots.push_back(slot);
+					r = requests[slot];
+					if ((result == -EINTR) || (result == -EAGAIN)) {
+						queue.retry(r);
+						continue;
+					}
+					if (result < 0)
+						throw std::system_error{-result, std::system_category(), "read"};
+
+					const size_type size = static_cast<size_type>(result);
+					if (size) {
+						const string_view data{ring_->buffer(slot), size};
+						callback(block{r.file, r.offset, data});
+					}
+					if (size && (size < r.length)) {
+						r.offset += size;
+						r.length -= size;
+						queue.retry(r);
+					} else {
+						queue.done(r); // end of file reached early if nothing was read
+					}
+				}
+			}
+		} catch (...) {
+			// the kernel must be done with the buffers before they are reused
+			try {
+				unsigned slot;
+				int result;
+				while (active) {
+					ring_->submit(1u);
+					while (active && ring_->complete(slot, result))
+						--active;
+				}
+			} catch (...) {
+				ring_.reset();
+			}
+			throw;
+		}
+	}
+
+	std::unique_ptr<ring> ring_;
+#endif
+
+private:
+	size_type block_size_;
+	unsigned queue_depth_;
+};
+}
+}
+
+#endif
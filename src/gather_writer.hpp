@@ -0,0 +1,181 @@
+#ifndef BACKPORT__CPP11__GATHER_WRITER__HPP
+#define BACKPORT__CPP11__GATHER_WRITER__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <memory>
+#include <vector>
+#include <system_error>
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Collects views and writes them with `writev` to a file descriptor.
+///
+/// Views shorter than the coalescing threshold are copied into an inline buffer,
+/// consecutive small views end up in the same `iovec`. Longer views are referred to
+/// directly and must stay valid until they are flushed.
+///
+/// Data is flushed when the inline buffer or the `iovec` array is full, by
+/// `flush` and by the destructor. The file descriptor is not owned. Errors are
+/// reported by throwing `std::system_error`.
+///
+/// POSIX only.
+///
+class gather_writer
+{
+public:
+	using size_type = std::size_t;
+
+public: // constants
+	static constexpr size_type default_buffer_size = 4096u;
+	static constexpr size_type default_threshold = 128u;
+
+#if defined(IOV_MAX)
+	static constexpr size_type max_iovecs = (IOV_MAX < 1024) ? IOV_MAX : 1024;
+#else
+	static constexpr size_type max_iovecs = 16u;
+#endif
+
+public: // construction
+	explicit gather_writer(int fd, size_type buffer_size = default_buffer_size,
+		size_type threshold = default_threshold)
+		: fd_(fd)
+		, capacity_(buffer_size)
+		, threshold_(std::min(threshold, buffer_size))
+		, buffer_(new char[buffer_size])
+	{
+		iov_.reserve(max_iovecs);
+	}
+
+	gather_writer(const gather_writer &) = delete;
+
+	~gather_writer()
+	{
+		try {
+			flush();
+		} catch (...) {
+		}
+	}
+
+public: // assignment
+	gather_writer & operator=(const gather_writer &) = delete;
+
+public: // capacity
+	/// Number of characters not yet written.
+	size_type pending() const noexcept { return pending_; }
+
+public: // operations
+	gather_writer & append(string_view v)
+	{
+		if (v.size() == 0u)
+			return *this;
+
+		if (v.size() < threshold_) {
+			if (capacity_ - used_ < v.size())
+				flush();
+			char * p = buffer_.get() + used_;
+			const bool coalesce = !iov_.empty()
+				&& (static_cast<char *>(iov_.back().iov_base) + iov_.back().iov_len == p);
+			if (!coalesce && (iov_.size() == max_iovecs)) {
+				flush();
+				p = buffer_.get();
+			}
+			std::char_traits<char>::copy(p, v.data(), v.size());
+			used_ += v.size();
+			if (coalesce) {
+				iov_.back().iov_len += v.size();
+				pending_ += v.size();
+			} else {
+				push(p, v.size());
+			}
+		} else {
+			push(v.data(), v.size());
+		}
+		return *this;
+	}
+
+	gather_writer & operator<<(string_view v) { return append(v); }
+
+	/// Writes all pending data.
+	void flush()
+	{
+		std::size_t first = 0u;
+		while (first < iov_.size()) {
+			const int count = static_cast<int>(iov_.size() - first); // at most max_iovecs
+			const ssize_t n = ::writev(fd_, iov_.data() + first, count);
+			if (n < 0) {
+				const int error = errno;
+				if (error == EINTR)
+					continue;
+				// keep only what is left, a later flush must not repeat written data
+				iov_.erase(iov_.begin(), iov_.begin() + static_cast<std::ptrdiff_t>(first));
+				throw std::system_error{error, std::system_category(), "writev"};
+			}
+
+			// skip completely written vectors, adjust a partially written one
+			size_type done = static_cast<size_type>(n);
+			pending_ -= done;
+			while ((first < iov_.size()) && (done >= iov_[first].iov_len)) {
+				done -= iov_[first].iov_len;
+				++first;
+			}
+			if (done) {
+				iov_[first].iov_base = static_cast<char *>(iov_[first].iov_base) + done;
+				iov_[first].iov_len -= done;
+			}
+		}
+		iov_.clear();
+		used_ = 0u;
+	}
+
+private:
+	void push(const char * p, size_type n)
+	{
+		if (iov_.size() == max_iovecs)
+			flush();
+		iov_.push_back(::iovec{const_cast<char *>(p), n});
+		pending_ += n;
+	}
+
+private:
+	int fd_;
+	size_type capacity_;
+	size_type threshold_;
+	std::unique_ptr<char[]> buffer_;
+	size_type used_ = 0u;
+	size_type pending_ = 0u;
+	std::vector<::iovec> iov_;
+};
+}
+}
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef BACKPORT__CPP11__ISO8601__HPP
+#define BACKPORT__CPP11__ISO8601__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Result of `parse_iso8601`: nanoseconds since 1970-01-01T00:00:00Z, valid if `ok`.
+///
+struct iso8601_result {
+	std::int64_t epoch_nanos;
+	bool ok;
+};
+
+namespace detail
+{
+/// Days since 1970-01-01 of a date in the proleptic Gregorian calendar.
+inline std::int64_t days_from_civil(int y, unsigned m, unsigned d) noexcept
+{
+	y -= (m <= 2u) ? 1 : 0;
+	const int era = ((y >= 0) ? y : (y - 399)) / 400;
+	const auto yoe = static_cast<unsigned>(y - (era * 400));
+	const unsigned doy = (((153u * ((m > 2u) ? (m - 3u) : (m + 9u))) + 2u) / 5u) + d - 1u;
+	const unsigned doe = (yoe * 365u) + (yoe / 4u) - (yoe / 100u) + doy;
+	return (std::int64_t{era} * 146097) + doe - 719468;
+}
+
+inline unsigned days_in_month(unsigned y, unsigned m) noexcept
+{
+	static constexpr unsigned char days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	const bool leap = ((y % 4u) == 0u) && (((y % 100u) != 0u) || ((y % 400u) == 0u));
+	return days[m - 1u] + (((m == 2u) && leap) ? 1u : 0u);
+}
+
+inline bool two_digits(const char * p, unsigned & value) noexcept
+{
+	const auto a = static_cast<unsigned char>(p[0] - '0');
+	const auto b = static_cast<unsigned char>(p[1] - '0');
+	value = (a * 10u) + b;
+	return (a <= 9u) && (b <= 9u);
+}
+
+/// Date and time fields of the fixed part `YYYY-MM-DDTHH:MM`.
+struct date_time_fields {
+	unsigned year;
+	unsigned month;
+	unsigned day;
+	unsigned hour;
+	unsigned minute;
+};
+
+///
+/// Validates and converts `YYYY-MM-DDTHH:MM` (16 characters, the separator between
+/// date and time is checked by the caller).
+///
+/// With SSE2 the characters are loaded into one vector, the expected characters
+/// are subtracted and all positions are range checked with one comparison. The
+/// digits are then combined with a single multiply-add of pairs, separators being
+/// weighted with zero.
+///
+inline bool parse_date_time(const char * p, date_time_fields & f) noexcept
+{
+#if defined(__SSE2__)
+	const __m128i x = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)),
+		_mm_setr_epi8('0', '0', '0', '0', '-', '0', '0', '-', '0', '0', p[10], '0', '0', ':',
+			'0', '0'));
+	const __m128i limit = _mm_setr_epi8(9, 9, 9, 9, 0, 9, 9, 0, 9, 9, 0, 9, 9, 0, 9, 9);
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(x, limit), limit)) != 0xffff)
+		return false;
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i low = _mm_madd_epi16(
+		_mm_unpacklo_epi8(x, zero), _mm_setr_epi16(1000, 100, 10, 1, 0, 10, 1, 0));
+	const __m128i high = _mm_madd_epi16(
+		_mm_unpackhi_epi8(x, zero), _mm_setr_epi16(10, 1, 0, 10, 1, 0, 10, 1));
+	alignas(16) std::int32_t v[8];
+	_mm_store_si128(reinterpret_cast<__m128i *>(v), low);
+	_mm_store_si128(reinterpret_cast<__m128i *>(v + 4), high);
+
+	f.year = static_cast<unsigned>(v[0] + v[1]);
+	f.month = static_cast<unsigned>(v[2] + v[3]);
+	f.day = static_cast<unsigned>(v[4]);
+	f.hour = static_cast<unsigned>(v[5] + v[6]);
+	f.minute = static_cast<unsigned>(v[7]);
+	return true;
+#else
+	unsigned century;
+	unsigned year;
+	if (!two_digits(p, century) || !two_digits(p + 2, year) || (p[4] != '-')
+		|| !two_digits(p + 5, f.month) || (p[7] != '-') || !two_digits(p + 8, f.day)
+		|| !two_digits(p + 11, f.hour) || (p[13] != ':') || !two_digits(p + 14, f.minute))
+		return false;
+	f.year = (century * 100u) + year;
+	return true;
+#endif
+}
+}
+
+///
+/// Parses a timestamp of the form `2026-10-16T12:34:56.789Z` (RFC 3339 / ISO 8601
+/// extended format). The whole view has to match.
+///
+/// The separator between date and time may be `T`, `t` or a space. Fractional
+/// seconds (`.` or `,`) may have any number of digits, those beyond nanoseconds are
+/// truncated. The time zone is `Z`, `z` or an offset `+HH:MM`, `+HHMM` or `+HH`;
+/// without it the time is taken as UTC. A leap second (`:60`) is accepted and
+/// counts as the first second of the next minute.
+///
+/// The fixed part is validated and converted in one vector operation (SSE2), no
+/// copy of the input and no locale is needed. Timestamps outside of the range of
+/// `std::int64_t` nanoseconds (years 1677 to 2262) are not `ok`.
+///
+inline iso8601_result parse_iso8601(string_view s) noexcept
+{
+	static constexpr iso8601_result failure = {0, false};
+
+	if (s.size() < 19u)
+		return failure;
+	const char * p = s.data();
+	const char * const last = p + s.size();
+
+	if ((p[10] != 'T') && (p[10] != 't') && (p[10] != ' '))
+		return failure;
+	detail::date_time_fields f;
+	unsigned second;
+	if (!detail::parse_date_time(p, f) || (p[16] != ':') || !detail::two_digits(p + 17, second))
+		return failure;
+	if ((f.month < 1u) || (f.month > 12u) || (f.day < 1u)
+		|| (f.day > detail::days_in_month(f.year, f.month)) || (f.hour > 23u)
+		|| (f.minute > 59u) || (second > 60u))
+		return failure;
+	p += 19;
+
+	std::int64_t nanos = 0;
+	if ((p != last) && ((*p == '.') || (*p == ','))) {
+		const char * const fraction = ++p;
+		std::int64_t scale = 1000000000;
+		for (; (p != last) && (static_cast<unsigned char>(*p - '0') <= 9u); ++p) {
+			if (scale > 1) {
+				scale /= 10;
+				nanos += (*p - '0') * scale;
+			}
+		}
+		if (p == fraction)
+			return failure;
+	}
+
+	std::int64_t offset = 0;
+	if (p != last) {
+		if ((*p == 'Z') || (*p == 'z')) {
+			++p;
+		} else if ((*p == '+') || (*p == '-')) {
+			const bool negative = *p == '-';
+			unsigned hours;
+			unsigned minutes = 0u;
+			if ((last - p < 3) || !detail::two_digits(p + 1, hours))
+				return failure;
+			p += 3;
+			const bool colon = (p != last) && (*p == ':');
+			if (colon)
+				++p;
+			if (colon || (p != last)) {
+				if ((last - p < 2) || !detail::two_digits(p, minutes))
+					return failure;
+				p += 2;
+			}
+			if ((hours > 23u) || (minutes > 59u))
+				return failure;
+			offset = (std::int64_t{hours} * 3600) + (minutes * 60);
+			if (negative)
+				offset = -offset;
+		}
+		if (p != last)
+			return failure;
+	}
+
+	const std::int64_t seconds
+		= (detail::days_from_civil(static_cast<int>(f.year), f.month, f.day) * 86400)
+		+ (f.hour * 3600) + (f.minute * 60) + second - offset;
+
+	// limits of std::int64_t nanoseconds
+	if ((seconds < -9223372037) || ((seconds == -9223372037) && (nanos < 145224192))
+		|| (seconds > 9223372036) || ((seconds == 9223372036) && (nanos > 854775807)))
+		return failure;
+	// without overflow at the lower limit, where the seconds alone do not fit
+	if (seconds < 0)
+		return {((seconds + 1) * 1000000000) + (nanos - 1000000000), true};
+	return {(seconds * 1000000000) + nanos, true};
+}
+}
+}
+
+#endif
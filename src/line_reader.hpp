@@ -0,0 +1,144 @@
+#ifndef BACKPORT__CPP11__LINE_READER__HPP
+#define BACKPORT__CPP11__LINE_READER__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <memory>
+#include <system_error>
+#include <cerrno>
+#include <unistd.h>
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Reads lines from a file descriptor, yielding views into an internal buffer.
+///
+/// Lines are located with `std::char_traits<char>::find` (`memchr`), no per line
+/// allocation takes place. Once the buffer is full, the data of the incomplete
+/// line at its end is moved to the front, the buffer grows only if a single line
+/// does not fit. Views are valid until the next call of `next`.
+///
+/// The file descriptor is not owned. Errors are reported by throwing
+/// `std::system_error`.
+///
+/// POSIX only.
+///
+class line_reader
+{
+public:
+	using size_type = std::size_t;
+
+public: // constants
+	static constexpr size_type default_buffer_size = 1024u * 1024u;
+
+public: // construction
+	explicit line_reader(int fd, size_type buffer_size = default_buffer_size)
+		: fd_(fd)
+		, capacity_(std::max(buffer_size, size_type{1}))
+		, buffer_(new char[capacity_])
+	{
+	}
+
+public: // operations
+	/// Provides the next line without the newline character.
+	///
+	/// Returns `false` if there are no more lines. The last line does not need to
+	/// be terminated by a newline.
+	bool next(string_view & line)
+	{
+		for (;;) {
+			const char * const first = buffer_.get() + begin_;
+			const char * const scan = buffer_.get() + scan_;
+			const char * nl = std::char_traits<char>::find(scan, end_ - scan_, '\n');
+			if (nl) {
+				line = string_view{first, static_cast<size_type>(nl - first)};
+				begin_ = scan_ = (nl - buffer_.get()) + 1u;
+				return true;
+			}
+			scan_ = end_;
+
+			if (eof_) {
+				if (begin_ == end_)
+					return false;
+				line = string_view{first, end_ - begin_};
+				begin_ = scan_ = end_;
+				return true;
+			}
+
+			fill();
+		}
+	}
+
+	/// Returns `true` after the end of the input has been read.
+	bool eof() const noexcept { return eof_; }
+
+private:
+	void fill()
+	{
+		if (begin_ == end_) {
+			begin_ = scan_ = end_ = 0u;
+		} else if (end_ == capacity_) {
+			if (begin_ > 0u) {
+				// move the incomplete line to the front, once per line
+				std::char_traits<char>::move(
+					buffer_.get(), buffer_.get() + begin_, end_ - begin_);
+				end_ -= begin_;
+				scan_ -= begin_;
+				begin_ = 0u;
+			} else {
+				// a single line fills the whole buffer
+				std::unique_ptr<char[]> tmp{new char[2u * capacity_]};
+				std::char_traits<char>::copy(tmp.get(), buffer_.get(), end_);
+				buffer_.swap(tmp);
+				capacity_ *= 2u;
+			}
+		}
+
+		ssize_t n;
+		do {
+			n = ::read(fd_, buffer_.get() + end_, capacity_ - end_);
+		} while ((n < 0) && (errno == EINTR));
+		if (n < 0)
+			throw std::system_error{errno, std::system_category(), "read"};
+		if (n == 0)
+			eof_ = true;
+		end_ += static_cast<size_type>(n);
+	}
+
+private:
+	int fd_;
+	size_type capacity_;
+	std::unique_ptr<char[]> buffer_;
+	size_type begin_ = 0u; // start of the current line
+	size_type scan_ = 0u; // data before this position contains no newline
+	size_type end_ = 0u; // end of data
+	bool eof_ = false;
+};
+}
+}
+
+#endif
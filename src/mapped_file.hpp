@@ -0,0 +1,232 @@
+#ifndef BACKPORT__CPP11__MAPPED_FILE__HPP
+#define BACKPORT__CPP11__MAPPED_FILE__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <system_error>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Read only memory mapping of a file, accessible as `string_view`.
+///
+/// The options control how the kernel is advised about the expected access pattern:
+///
+/// - `sequential`: `MADV_SEQUENTIAL`, aggressive read ahead, pages dropped after use
+/// - `willneed`: `MADV_WILLNEED`, starts reading the file in the background
+/// - `populate`: `MAP_POPULATE`, prefaults the whole file while mapping
+/// - `huge_pages`: `MADV_HUGEPAGE`, transparent huge pages if the file system supports them
+///
+/// Options not supported by the platform are ignored. Errors are reported
+/// by throwing `std::system_error`.
+///
+/// POSIX only.
+///
+class mapped_file
+{
+public:
+	using size_type = std::size_t;
+
+	enum option : unsigned {
+		none = 0u,
+		sequential = 1u << 0,
+		willneed = 1u << 1,
+		populate = 1u << 2,
+		huge_pages = 1u << 3,
+	};
+
+public: // construction
+	mapped_file() noexcept = default;
+
+	explicit mapped_file(const char * path, unsigned options = none)
+		: options_(options)
+	{
+		fd_ = ::open(path, O_RDONLY | O_CLOEXEC);
+		if (fd_ < 0)
+			throw std::system_error{errno, std::system_category(), "open"};
+		try {
+			map(file_size());
+		} catch (...) {
+			::close(fd_);
+			throw;
+		}
+	}
+
+	explicit mapped_file(const std::string & path, unsigned options = none)
+		: mapped_file(path.c_str(), options)
+	{
+	}
+
+	mapped_file(const mapped_file &) = delete;
+
+	mapped_file(mapped_file && other) noexcept
+		: fd_(other.fd_)
+		, options_(other.options_)
+		, data_(other.data_)
+		, size_(other.size_)
+	{
+		other.fd_ = -1;
+		other.data_ = nullptr;
+		other.size_ = 0u;
+	}
+
+	~mapped_file() { close(); }
+
+public: // assignment
+	mapped_file & operator=(const mapped_file &) = delete;
+
+	mapped_file & operator=(mapped_file && other) noexcept
+	{
+		mapped_file tmp{std::move(other)};
+		swap(tmp);
+		return *this;
+	}
+
+public: // access
+	/// View to the whole file, valid until the next `remap` or `close`.
+	string_view view() const noexcept
+	{
+		return data_ ? string_view{data_, size_} : string_view{"", 0u};
+	}
+
+	operator string_view() const noexcept { return view(); }
+
+	const char * data() const noexcept { return data_; }
+
+	size_type size() const noexcept { return size_; }
+
+	bool empty() const noexcept { return size_ == 0u; }
+
+	bool is_open() const noexcept { return fd_ >= 0; }
+
+public: // modifiers
+	/// Adjusts the mapping to the current size of the file, e.g. after it has grown.
+	///
+	/// Returns `true` if the size has changed, all views are invalidated in this case.
+	bool remap()
+	{
+		if (!is_open())
+			return false;
+		const size_type n = file_size();
+		if (n == size_)
+			return false;
+#if defined(MREMAP_MAYMOVE)
+		if (data_ && (n > 0u)) {
+			void * p = ::mremap(const_cast<char *>(data_), size_, n, MREMAP_MAYMOVE);
+			if (p == MAP_FAILED)
+				throw std::system_error{errno, std::system_category(), "mremap"};
+			data_ = static_cast<const char *>(p);
+			size_ = n;
+			advise();
+			return true;
+		}
+#endif
+		unmap();
+		map(n);
+		return true;
+	}
+
+	void close() noexcept
+	{
+		unmap();
+		if (fd_ >= 0)
+			::close(fd_);
+		fd_ = -1;
+	}
+
+	void swap(mapped_file & other) noexcept
+	{
+		std::swap(fd_, other.fd_);
+		std::swap(options_, other.options_);
+		std::swap(data_, other.data_);
+		std::swap(size_, other.size_);
+	}
+
+private:
+	size_type file_size() const
+	{
+		struct stat st;
+		if (::fstat(fd_, &st) < 0)
+			throw std::system_error{errno, std::system_category(), "fstat"};
+		return static_cast<size_type>(st.st_size);
+	}
+
+	void map(size_type n)
+	{
+		if (n == 0u)
+			return; // empty files cannot be mapped
+
+		int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+		if (options_ & populate)
+			flags |= MAP_POPULATE;
+#endif
+		void * p = ::mmap(nullptr, n, PROT_READ, flags, fd_, 0);
+		if (p == MAP_FAILED)
+			throw std::system_error{errno, std::system_category(), "mmap"};
+		data_ = static_cast<const char *>(p);
+		size_ = n;
+		advise();
+	}
+
+	void unmap() noexcept
+	{
+		if (data_)
+			::munmap(const_cast<char *>(data_), size_);
+		data_ = nullptr;
+		size_ = 0u;
+	}
+
+	void advise() noexcept
+	{
+		// advice is a hint, failures are not relevant
+		void * p = const_cast<char *>(data_);
+		if (options_ & sequential)
+			::madvise(p, size_, MADV_SEQUENTIAL);
+		if (options_ & willneed)
+			::madvise(p, size_, MADV_WILLNEED);
+#if defined(MADV_HUGEPAGE)
+		if (options_ & huge_pages)
+			::madvise(p, size_, MADV_HUGEPAGE);
+#endif
+	}
+
+private:
+	int fd_ = -1;
+	unsigned options_ = none;
+	const char * data_ = nullptr;
+	size_type size_ = 0u;
+};
+}
+}
+
+#endif
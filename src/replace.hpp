@@ -0,0 +1,118 @@
+#ifndef BACKPORT__CPP11__REPLACE__HPP
+#define BACKPORT__CPP11__REPLACE__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include "string_searcher.hpp"
+#include <vector>
+
+namespace backport
+{
+namespace cpp11
+{
+namespace detail
+{
+template <class CharT, class Traits, class Allocator>
+void reserve_more(std::basic_string<CharT, Traits, Allocator> & s, std::size_t n)
+{
+	s.reserve(s.size() + n);
+}
+
+template <class CharT, class Allocator>
+void reserve_more(std::vector<CharT, Allocator> & v, std::size_t n)
+{
+	v.reserve(v.size() + n);
+}
+
+template <class CharT, class Traits, class Allocator>
+void append_chars(
+	std::basic_string<CharT, Traits, Allocator> & s, const CharT * p, std::size_t n)
+{
+	s.append(p, n);
+}
+
+template <class CharT, class Allocator>
+void append_chars(std::vector<CharT, Allocator> & v, const CharT * p, std::size_t n)
+{
+	v.insert(v.end(), p, p + n);
+}
+}
+
+///
+/// Appends `src` to `out` with all non overlapping occurrences of the needle of
+/// `from` replaced by `to`, returns the number of replacements.
+///
+/// `out` is a `std::basic_string` or a `std::vector` of the character type and is
+/// reallocated at most once: if `to` is longer than the needle, the occurrences
+/// are counted first to reserve the exact size, otherwise the size of `src` is
+/// reserved. The unchanged parts are copied as a whole. An empty needle replaces
+/// nothing.
+///
+template <class CharT, class Traits, class OutBuf>
+std::size_t replace_all(detail::non_deduced_view<CharT, Traits> src,
+	const basic_string_searcher<CharT, Traits> & from,
+	detail::non_deduced_view<CharT, Traits> to, OutBuf & out)
+{
+	using view_type = basic_string_view<CharT, Traits>;
+
+	const std::size_t n = from.needle().size();
+	if (n == 0u) {
+		detail::append_chars(out, src.data(), src.size());
+		return 0u;
+	}
+
+	std::size_t extra = 0u;
+	if (to.size() > n) {
+		std::size_t count = 0u;
+		for (auto pos = from.find(src); pos != view_type::npos; pos = from.find(src, pos + n))
+			++count;
+		extra = count * (to.size() - n);
+	}
+	detail::reserve_more(out, src.size() + extra);
+
+	std::size_t count = 0u;
+	std::size_t begin = 0u;
+	for (auto pos = from.find(src); pos != view_type::npos; pos = from.find(src, pos + n)) {
+		detail::append_chars(out, src.data() + begin, pos - begin);
+		detail::append_chars(out, to.data(), to.size());
+		begin = pos + n;
+		++count;
+	}
+	detail::append_chars(out, src.data() + begin, src.size() - begin);
+	return count;
+}
+
+/// Same as above, preparing the searcher for `from`.
+template <class CharT, class Traits, class OutBuf>
+std::size_t replace_all(basic_string_view<CharT, Traits> src,
+	detail::non_deduced_view<CharT, Traits> from, detail::non_deduced_view<CharT, Traits> to,
+	OutBuf & out)
+{
+	return replace_all(src, basic_string_searcher<CharT, Traits>{from}, to, out);
+}
+}
+}
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef BACKPORT__CPP11__RING_BUFFER__HPP
+#define BACKPORT__CPP11__RING_BUFFER__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <system_error>
+#include <cerrno>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Ring buffer of characters, the readable data is always contiguous.
+///
+/// The same memory is mapped twice, back to back. Data wrapping around the end
+/// of the first mapping continues in the second one, so `view()` never has to
+/// be split and parsers are able to work in place on streaming input.
+///
+/// The capacity is rounded up to a multiple of the page size. The memory is obtained
+/// by `memfd_create` where available, an unlinked temporary file otherwise. Errors
+/// are reported by throwing `std::system_error`.
+///
+/// POSIX only.
+///
+class mirrored_ring_buffer
+{
+public:
+	using size_type = std::size_t;
+
+public: // construction
+	explicit mirrored_ring_buffer(size_type min_capacity)
+	{
+		const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+		capacity_ = std::max((min_capacity + page - 1u) / page * page, page);
+
+		const int fd = create_file();
+		try {
+			if (::ftruncate(fd, static_cast<off_t>(capacity_)) < 0)
+				throw std::system_error{errno, std::system_category(), "ftruncate"};
+			map(fd);
+		} catch (...) {
+			::close(fd);
+			throw;
+		}
+		::close(fd); // the mappings keep the memory alive
+	}
+
+	mirrored_ring_buffer(const mirrored_ring_buffer &) = delete;
+
+	mirrored_ring_buffer(mirrored_ring_buffer && other) noexcept
+		: data_(other.data_)
+		, capacity_(other.capacity_)
+		, read_(other.read_)
+		, size_(other.size_)
+	{
+		other.data_ = nullptr;
+		other.capacity_ = 0u;
+		other.read_ = 0u;
+		other.size_ = 0u;
+	}
+
+	~mirrored_ring_buffer()
+	{
+		if (data_)
+			::munmap(data_, 2u * capacity_);
+	}
+
+public: // assignment
+	mirrored_ring_buffer & operator=(const mirrored_ring_buffer &) = delete;
+
+	mirrored_ring_buffer & operator=(mirrored_ring_buffer && other) noexcept
+	{
+		mirrored_ring_buffer tmp{std::move(other)};
+		swap(tmp);
+		return *this;
+	}
+
+public: // capacity
+	size_type capacity() const noexcept { return capacity_; }
+
+	size_type size() const noexcept { return size_; }
+
+	bool empty() const noexcept { return size_ == 0u; }
+
+	bool full() const noexcept { return size_ == capacity_; }
+
+	/// Number of characters which can be written before the buffer is full.
+	size_type available() const noexcept { return capacity_ - size_; }
+
+public: // reading
+	/// Contiguous view to all readable data, valid until the next `consume`.
+	string_view view() const noexcept { return string_view{data_ + read_, size_}; }
+
+	/// Discards `n` characters from the front.
+	void consume(size_type n) noexcept
+	{
+		assert(n <= size_);
+		read_ += n;
+		if (read_ >= capacity_)
+			read_ -= capacity_;
+		size_ -= n;
+	}
+
+public: // writing
+	/// Contiguous storage of `available()` characters following the readable data.
+	char * write_data() noexcept { return data_ + read_ + size_; }
+
+	/// Makes `n` characters, written to `write_data()`, readable.
+	void commit(size_type n) noexcept
+	{
+		assert(n <= available());
+		size_ += n;
+	}
+
+	/// Copies as much of the view as fits, returns the number of characters written.
+	size_type write(string_view v) noexcept
+	{
+		const size_type n = std::min(v.size(), available());
+		std::char_traits<char>::copy(write_data(), v.data(), n);
+		commit(n);
+		return n;
+	}
+
+	/// Reads from a file descriptor into the free space, returns the result of `read`.
+	ssize_t read_from(int fd) noexcept
+	{
+		const ssize_t n = ::read(fd, write_data(), available());
+		if (n > 0)
+			commit(static_cast<size_type>(n));
+		return n;
+	}
+
+public: // modifiers
+	void clear() noexcept
+	{
+		read_ = 0u;
+		size_ = 0u;
+	}
+
+	void swap(mirrored_ring_buffer & other) noexcept
+	{
+		std::swap(data_, other.data_);
+		std::swap(capacity_, other.capacity_);
+		std::swap(read_, other.read_);
+		std::swap(size_, other.size_);
+	}
+
+private:
+	static int create_file()
+	{
+#if defined(MFD_CLOEXEC)
+		const int fd = ::memfd_create("mirrored_ring_buffer", MFD_CLOEXEC);
+		if (fd < 0)
+			throw std::system_error{errno, std::system_category(), "memfd_create"};
+		return fd;
+#else
+		char path[] = "/tmp/mirrored_ring_buffer-XXXXXX";
+		const int fd = ::mkstemp(path);
+		if (fd < 0)
+			throw std::system_error{errno, std::system_category(), "mkstemp"};
+		::unlink(path);
+		return fd;
+#endif
+	}
+
+	void map(int fd)
+	{
+		// reserve address space for both mappings, then place the file twice within
+		void * p = ::mmap(
+			nullptr, 2u * capacity_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED)
+			throw std::system_error{errno, std::system_category(), "mmap"};
+		char * base = static_cast<char *>(p);
+
+		for (char * half : {base, base + capacity_}) {
+			if (::mmap(half, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0)
+				== MAP_FAILED) {
+				const int error = errno;
+				::munmap(base, 2u * capacity_);
+				throw std::system_error{error, std::system_category(), "mmap"};
+			}
+		}
+		data_ = base;
+	}
+
+private:
+	char * data_ = nullptr;
+	size_type capacity_ = 0u;
+	size_type read_ = 0u;
+	size_type size_ = 0u;
+};
+}
+}
+
+#endif
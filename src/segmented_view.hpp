@@ -0,0 +1,365 @@
+#ifndef BACKPORT__CPP11__SEGMENTED_VIEW__HPP
+#define BACKPORT__CPP11__SEGMENTED_VIEW__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <array>
+#include <vector>
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// View to the concatenation of a sequence of views, without flattening them.
+///
+/// Neither the segments nor the array holding them are owned, both have to
+/// outlive the segmented view. Positions are relative to the concatenation,
+/// searches find matches spanning segment boundaries.
+///
+/// Random access is linear in the number of segments.
+///
+template <class CharT, class Traits = std::char_traits<CharT>> class basic_segmented_view
+{
+public:
+	using view_type = basic_string_view<CharT, Traits>;
+	using traits_type = Traits;
+	using value_type = CharT;
+	using const_reference = const CharT &;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	class const_iterator
+	{
+		friend class basic_segmented_view;
+
+	public:
+		using difference_type = basic_segmented_view::difference_type;
+		using value_type = basic_segmented_view::value_type;
+		using pointer = const CharT *;
+		using reference = basic_segmented_view::const_reference;
+		using iterator_category = std::forward_iterator_tag;
+
+	public: // construction
+		const_iterator() noexcept = default;
+
+	public: // comparison operators
+		bool operator==(const const_iterator & other) const
+		{
+			return remaining_ == other.remaining_;
+		}
+
+		bool operator!=(const const_iterator & other) const { return !(*this == other); }
+
+	public: // modifiers
+		const_iterator & operator++()
+		{
+			advance(1u);
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator i{*this};
+			++(*this);
+			return i;
+		}
+
+	public: // access
+		const_reference operator*() const { return (*seg_)[local_]; }
+
+	private: // construction
+		const_iterator(const view_type * seg, size_type local, size_type remaining)
+			: seg_(seg)
+			, local_(local)
+			, remaining_(remaining)
+		{
+			normalize();
+		}
+
+	private:
+		/// Contiguous part of the data from the current position on.
+		view_type chunk() const { return seg_->substr(local_, remaining_); }
+
+		void advance(size_type n)
+		{
+			assert(n <= remaining_);
+			remaining_ -= n;
+			local_ += n;
+			normalize();
+		}
+
+		void normalize()
+		{
+			while (remaining_ && (local_ >= seg_->size())) {
+				local_ -= seg_->size();
+				++seg_;
+			}
+		}
+
+	private:
+		const view_type * seg_ = nullptr;
+		size_type local_ = 0u;
+		size_type remaining_ = 0u;
+	};
+
+	using iterator = const_iterator;
+
+public: // constants
+	static constexpr size_type npos = view_type::npos;
+
+public: // construction
+	basic_segmented_view() noexcept = default;
+
+	basic_segmented_view(const view_type * segments, size_type count) noexcept
+		: segs_(segments)
+		, count_(count)
+	{
+		for (size_type i = 0u; i < count; ++i)
+			size_ += segments[i].size();
+	}
+
+	template <class Allocator>
+	explicit basic_segmented_view(const std::vector<view_type, Allocator> & segments) noexcept
+		: basic_segmented_view(segments.data(), segments.size())
+	{
+	}
+
+	template <std::size_t N>
+	explicit basic_segmented_view(const std::array<view_type, N> & segments) noexcept
+		: basic_segmented_view(segments.data(), segments.size())
+	{
+	}
+
+public: // iterators
+	const_iterator begin() const { return const_iterator{segs_, skip_, size_}; }
+
+	const_iterator cbegin() const { return begin(); }
+
+	const_iterator end() const { return const_iterator{}; }
+
+	const_iterator cend() const { return end(); }
+
+public: // element access
+	const_reference operator[](size_type i) const { return *at_position(i); }
+
+	const_reference at(size_type i) const
+	{
+		if (i >= size_)
+			throw std::out_of_range("at");
+		return (*this)[i];
+	}
+
+	const_reference front() const { return (*this)[0]; }
+
+	const_reference back() const { return (*this)[size_ - 1]; }
+
+public: // capacity
+	size_type size() const noexcept { return size_; }
+
+	size_type length() const noexcept { return size_; }
+
+	bool empty() const noexcept { return size_ == 0u; }
+
+public: // operations
+	size_type copy(CharT * dest, size_type count, size_type pos = 0) const
+	{
+		if (pos >= size())
+			throw std::out_of_range{"copy"};
+		const size_type n = std::min(count, size_ - pos);
+		size_type done = 0u;
+		for (auto it = at_position(pos); done < n;) {
+			const view_type c = it.chunk().substr(0, n - done);
+			traits_type::copy(dest + done, c.data(), c.size());
+			done += c.size();
+			it.advance(c.size());
+		}
+		return n;
+	}
+
+	basic_segmented_view substr(size_type pos = 0, size_type count = npos) const
+	{
+		if (pos > size_)
+			throw std::out_of_range{"substr"};
+		const auto it = at_position(pos);
+		basic_segmented_view v;
+		v.segs_ = it.seg_;
+		v.count_ = (it.seg_ && (pos < size_)) ? (count_ - (it.seg_ - segs_)) : 0u;
+		v.skip_ = it.local_;
+		v.size_ = std::min(count, size_ - pos);
+		return v;
+	}
+
+	int compare(const basic_segmented_view & v) const noexcept
+	{
+		auto a = begin();
+		auto b = v.begin();
+		while (a.remaining_ && b.remaining_) {
+			const view_type ca = a.chunk();
+			const view_type cb = b.chunk();
+			const size_type n = std::min(ca.size(), cb.size());
+			const auto result = traits_type::compare(ca.data(), cb.data(), n);
+			if (result < 0)
+				return -1;
+			if (result > 0)
+				return +1;
+			a.advance(n);
+			b.advance(n);
+		}
+		if (size() < v.size())
+			return -1;
+		if (size() > v.size())
+			return +1;
+		return 0;
+	}
+
+	int compare(view_type v) const noexcept { return compare(basic_segmented_view{&v, 1u}); }
+
+	/// Finds the view, also if the match spans several segments.
+	size_type find(view_type v, size_type pos = 0) const noexcept
+	{
+		if (pos > size_)
+			return npos;
+		if (v.size() == 0u)
+			return pos;
+		for (auto it = at_position(pos); it.remaining_;) {
+			const view_type c = it.chunk();
+
+			// matches within the segment start before all matches crossing its end
+			const auto i = c.find(v);
+			if (i != npos)
+				return pos + i;
+
+			for (size_type j = (c.size() < v.size()) ? 0u : (c.size() - v.size() + 1u);
+				 j < c.size(); ++j) {
+				if (traits_type::eq(c[j], v[0]) && matches(it, j, v))
+					return pos + j;
+			}
+
+			pos += c.size();
+			it.advance(c.size());
+		}
+		return npos;
+	}
+
+	size_type find(CharT c, size_type pos = 0) const noexcept
+	{
+		return find_in_chunks(pos, [c](view_type chunk) { return chunk.find(c); });
+	}
+
+	size_type find_first_of(view_type v, size_type pos = 0) const noexcept
+	{
+		return find_in_chunks(pos, [v](view_type chunk) { return chunk.find_first_of(v); });
+	}
+
+	size_type find_first_of(CharT c, size_type pos = 0) const noexcept { return find(c, pos); }
+
+private:
+	const_iterator at_position(size_type pos) const
+	{
+		auto it = begin();
+		it.advance(std::min(pos, size_));
+		return it;
+	}
+
+	/// Checks if `v` matches at the offset `i` from the iterator, across segments.
+	static bool matches(const_iterator it, size_type i, view_type v) noexcept
+	{
+		if (it.remaining_ - i < v.size())
+			return false;
+		it.advance(i);
+		while (v.size()) {
+			const view_type c = it.chunk().substr(0, v.size());
+			if (traits_type::compare(c.data(), v.data(), c.size()) != 0)
+				return false;
+			v.remove_prefix(c.size());
+			it.advance(c.size());
+		}
+		return true;
+	}
+
+	/// Searches chunk by chunk, for searches which cannot span segments.
+	template <class Search> size_type find_in_chunks(size_type pos, Search search) const
+	{
+		if (pos >= size_)
+			return npos;
+		for (auto it = at_position(pos); it.remaining_;) {
+			const view_type c = it.chunk();
+			const auto i = search(c);
+			if (i != npos)
+				return pos + i;
+			pos += c.size();
+			it.advance(c.size());
+		}
+		return npos;
+	}
+
+private:
+	const view_type * segs_ = nullptr;
+	size_type count_ = 0u;
+	size_type skip_ = 0u; // characters skipped within the first segment
+	size_type size_ = 0u;
+};
+
+template <class CharT, class Traits>
+constexpr typename basic_segmented_view<CharT, Traits>::size_type
+	basic_segmented_view<CharT, Traits>::npos;
+
+// comparison operators
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator==(const basic_segmented_view<CharT, Traits> & a,
+	const basic_segmented_view<CharT, Traits> & b) noexcept
+{
+	return (a.size() == b.size()) && (a.compare(b) == 0);
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator==(const basic_segmented_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return (a.size() == b.size()) && (a.compare(b) == 0);
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator!=(const basic_segmented_view<CharT, Traits> & a,
+	const basic_segmented_view<CharT, Traits> & b) noexcept
+{
+	return !(a == b);
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator!=(const basic_segmented_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return !(a == b);
+}
+
+// default types
+using segmented_view = basic_segmented_view<char>;
+}
+}
+
+#endif
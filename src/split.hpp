@@ -0,0 +1,279 @@
+#ifndef BACKPORT__CPP11__SPLIT__HPP
+#define BACKPORT__CPP11__SPLIT__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include "char_set.hpp"
+#include <array>
+#include <utility>
+
+namespace backport
+{
+namespace cpp11
+{
+/// Handling of empty fields while splitting.
+enum class empty_fields { keep, skip };
+
+namespace detail
+{
+// Delimiters for `split`: `find` returns position and length of the next delimiter.
+
+template <class CharT, class Traits> struct char_delimiter {
+	using view_type = basic_string_view<CharT, Traits>;
+
+	std::pair<std::size_t, std::size_t> find(view_type v) const noexcept
+	{
+		return {v.find(c), 1u};
+	}
+
+	CharT c;
+};
+
+template <class CharT, class Traits> struct view_delimiter {
+	using view_type = basic_string_view<CharT, Traits>;
+
+	std::pair<std::size_t, std::size_t> find(view_type v) const noexcept
+	{
+		// an empty delimiter does not split at all
+		return {d.size() ? v.find(d) : view_type::npos, d.size()};
+	}
+
+	view_type d;
+};
+
+struct set_delimiter {
+	std::pair<std::size_t, std::size_t> find(string_view v) const noexcept
+	{
+		return {s.find(v), 1u};
+	}
+
+	char_set s;
+};
+}
+
+///
+/// Range of the fields of a view, separated by a delimiter, created by `split`.
+///
+/// Fields are found one at a time while iterating, no memory is allocated. After
+/// `max_splits` fields the remaining data is the last field, unsplit.
+///
+template <class CharT, class Traits, class Delimiter> class basic_split_range
+{
+public:
+	using view_type = basic_string_view<CharT, Traits>;
+	using size_type = std::size_t;
+
+	class const_iterator
+	{
+		friend class basic_split_range;
+
+	public:
+		using difference_type = std::ptrdiff_t;
+		using value_type = view_type;
+		using pointer = const view_type *;
+		using reference = const view_type &;
+		using iterator_category = std::forward_iterator_tag;
+
+	public: // construction
+		const_iterator() noexcept = default;
+
+	public: // comparison operators
+		bool operator==(const const_iterator & other) const noexcept
+		{
+			return (end_ == other.end_)
+				&& (end_ || ((count_ == other.count_) && (range_ == other.range_)));
+		}
+
+		bool operator!=(const const_iterator & other) const noexcept
+		{
+			return !(*this == other);
+		}
+
+	public: // modifiers
+		const_iterator & operator++()
+		{
+			advance();
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator i{*this};
+			++(*this);
+			return i;
+		}
+
+	public: // access
+		reference operator*() const noexcept { return field_; }
+
+		pointer operator->() const noexcept { return &field_; }
+
+	private: // construction
+		explicit const_iterator(const basic_split_range * range)
+			: range_(range)
+			, rest_(range->data_)
+			, end_(false)
+		{
+			advance();
+		}
+
+	private:
+		void advance()
+		{
+			for (;;) {
+				if (last_) {
+					end_ = true;
+					return;
+				}
+				const auto d = (count_ == range_->max_splits_)
+					? std::pair<size_type, size_type>{view_type::npos, 0u}
+					: range_->delimiter_.find(rest_);
+				if (d.first == view_type::npos) {
+					field_ = rest_;
+					last_ = true;
+				} else {
+					field_ = rest_.substr(0, d.first);
+					rest_.remove_prefix(d.first + d.second);
+				}
+				if (!field_.empty() || (range_->empty_ == empty_fields::keep)) {
+					++count_;
+					return;
+				}
+			}
+		}
+
+	private:
+		const basic_split_range * range_ = nullptr;
+		view_type rest_;
+		view_type field_;
+		size_type count_ = 0u;
+		bool last_ = false; // no data left after the current field
+		bool end_ = true;
+	};
+
+	using iterator = const_iterator;
+
+public: // construction
+	basic_split_range(
+		view_type data, Delimiter delimiter, empty_fields empty, size_type max_splits)
+		: data_(data)
+		, delimiter_(delimiter)
+		, empty_(empty)
+		, max_splits_(max_splits)
+	{
+	}
+
+public: // iterators
+	const_iterator begin() const { return const_iterator{this}; }
+
+	const_iterator end() const { return const_iterator{}; }
+
+private:
+	view_type data_;
+	Delimiter delimiter_;
+	empty_fields empty_;
+	size_type max_splits_;
+};
+
+/// Splits the view at every occurrence of the character.
+template <class CharT, class Traits>
+basic_split_range<CharT, Traits, detail::char_delimiter<CharT, Traits>> split(
+	basic_string_view<CharT, Traits> v, CharT delimiter,
+	empty_fields empty = empty_fields::keep,
+	std::size_t max_splits = basic_string_view<CharT, Traits>::npos)
+{
+	return {v, detail::char_delimiter<CharT, Traits>{delimiter}, empty, max_splits};
+}
+
+/// Splits the view at every occurrence of the delimiter, an empty delimiter does not split.
+template <class CharT, class Traits>
+basic_split_range<CharT, Traits, detail::view_delimiter<CharT, Traits>> split(
+	basic_string_view<CharT, Traits> v, detail::non_deduced_view<CharT, Traits> delimiter,
+	empty_fields empty = empty_fields::keep,
+	std::size_t max_splits = basic_string_view<CharT, Traits>::npos)
+{
+	return {v, detail::view_delimiter<CharT, Traits>{delimiter}, empty, max_splits};
+}
+
+/// Splits the view at every character contained in the set.
+inline basic_split_range<char, std::char_traits<char>, detail::set_delimiter> split(
+	string_view v, const char_set & delimiters, empty_fields empty = empty_fields::keep,
+	std::size_t max_splits = string_view::npos)
+{
+	return {v, detail::set_delimiter{delimiters}, empty, max_splits};
+}
+
+///
+/// Fields of a view with a known maximum number of fields, result of `split_n`.
+///
+template <std::size_t N, class CharT, class Traits = std::char_traits<CharT>>
+struct basic_split_n_result {
+	std::array<basic_string_view<CharT, Traits>, N> fields; ///< unused fields are empty
+	std::size_t count; ///< number of fields found
+};
+
+namespace detail
+{
+template <std::size_t N, class CharT, class Traits, class Delimiter>
+basic_split_n_result<N, CharT, Traits> split_n(
+	basic_string_view<CharT, Traits> v, const Delimiter & delimiter) noexcept
+{
+	static_assert(N > 0u, "at least one field required");
+
+	basic_split_n_result<N, CharT, Traits> result;
+	result.count = 0u;
+	for (std::size_t i = 0u; i < N - 1u; ++i) {
+		const auto d = delimiter.find(v);
+		if (d.first == basic_string_view<CharT, Traits>::npos)
+			break;
+		result.fields[result.count++] = v.substr(0, d.first);
+		v.remove_prefix(d.first + d.second);
+	}
+	result.fields[result.count++] = v;
+	return result;
+}
+}
+
+/// Splits the view into at most `N` fields, the last one holds the unsplit remainder.
+///
+/// For fixed schema records, no iterator and no allocation is involved, the
+/// delimiters are located with `traits_type::find` (`memchr` for `char`).
+template <std::size_t N, class CharT, class Traits>
+basic_split_n_result<N, CharT, Traits> split_n(
+	basic_string_view<CharT, Traits> v, CharT delimiter) noexcept
+{
+	return detail::split_n<N>(v, detail::char_delimiter<CharT, Traits>{delimiter});
+}
+
+/// Splits the view into at most `N` fields at characters contained in the set.
+template <std::size_t N>
+basic_split_n_result<N, char> split_n(string_view v, const char_set & delimiters) noexcept
+{
+	return detail::split_n<N>(v, detail::set_delimiter{delimiters});
+}
+}
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef BACKPORT__CPP11__STREAM_SEARCHER__HPP
+#define BACKPORT__CPP11__STREAM_SEARCHER__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <vector>
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Searches a needle within a stream which is fed chunk by chunk.
+///
+/// The state between chunks is the length of the needle prefix matched so far
+/// (Knuth-Morris-Pratt), so a needle split across chunks is found without
+/// buffering any data. While nothing is matched, the next candidate is located
+/// with `traits_type::find`.
+///
+/// Matches are reported as offsets from the start of the stream, overlapping
+/// matches included.
+///
+template <class CharT, class Traits = std::char_traits<CharT>> class basic_stream_searcher
+{
+public:
+	using view_type = basic_string_view<CharT, Traits>;
+	using traits_type = Traits;
+	using size_type = std::size_t;
+
+public: // construction
+	explicit basic_stream_searcher(view_type needle)
+		: needle_(needle.data(), needle.size())
+		, fail_(needle.size() + 1u, 0u)
+	{
+		if (needle_.empty())
+			throw std::invalid_argument{"empty needle"};
+
+		// fail_[i]: length of the longest proper border of the first i characters
+		size_type k = 0u;
+		for (size_type i = 1u; i < needle_.size(); ++i) {
+			while (k && !traits_type::eq(needle_[i], needle_[k]))
+				k = fail_[k];
+			if (traits_type::eq(needle_[i], needle_[k]))
+				++k;
+			fail_[i + 1u] = k;
+		}
+	}
+
+public: // access
+	view_type needle() const noexcept { return view_type{needle_.data(), needle_.size()}; }
+
+	/// Number of characters fed so far.
+	size_type position() const noexcept { return position_; }
+
+	/// Length of the needle prefix matching the end of the data fed so far.
+	size_type partial_match() const noexcept { return state_; }
+
+public: // operations
+	/// Searches the next chunk, writes the stream offsets of all matches ending within.
+	template <class OutputIt> OutputIt feed(view_type chunk, OutputIt out)
+	{
+		const CharT * p = chunk.data();
+		const CharT * const last = p + chunk.size();
+		const size_type m = needle_.size();
+
+		while (p != last) {
+			if (state_ == 0u) {
+				p = traits_type::find(p, last - p, needle_[0]);
+				if (!p)
+					break;
+			}
+			while (state_ && !traits_type::eq(*p, needle_[state_]))
+				state_ = fail_[state_];
+			if (traits_type::eq(*p, needle_[state_]))
+				++state_;
+			++p;
+			if (state_ == m) {
+				*out++ = position_ + (p - chunk.data()) - m;
+				state_ = fail_[m];
+			}
+		}
+		position_ += chunk.size();
+		return out;
+	}
+
+	/// Searches the next chunk, returns the stream offsets of all matches ending within.
+	std::vector<size_type> feed(view_type chunk)
+	{
+		std::vector<size_type> result;
+		feed(chunk, std::back_inserter(result));
+		return result;
+	}
+
+	/// Starts over with a new stream.
+	void reset() noexcept
+	{
+		position_ = 0u;
+		state_ = 0u;
+	}
+
+private:
+	std::basic_string<CharT, Traits> needle_;
+	std::vector<size_type> fail_;
+	size_type position_ = 0u;
+	size_type state_ = 0u;
+};
+
+// default types
+using stream_searcher = basic_stream_searcher<char>;
+}
+}
+
+#endif
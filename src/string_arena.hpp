@@ -0,0 +1,251 @@
+#ifndef BACKPORT__CPP11__STRING_ARENA__HPP
+#define BACKPORT__CPP11__STRING_ARENA__HPP
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Bump allocator for character data, handing out views to the stored copies.
+///
+/// Memory is taken from large chunks, views returned by `store` stay valid until
+/// the next `reset` or the destruction of the arena. With `huge_pages` set, chunks
+/// are mapped anonymously and advised to be backed by transparent huge pages
+/// (Linux only, falls back to the heap otherwise).
+///
+/// The arena is not synchronized, use one arena per thread.
+///
+template <class CharT, class Traits = std::char_traits<CharT>> class basic_string_arena
+{
+public:
+	using traits_type = Traits;
+	using value_type = CharT;
+	using size_type = std::size_t;
+	using view_type = basic_string_view<CharT, Traits>;
+
+public: // constants
+	static constexpr size_type default_chunk_size = 64u * 1024u;
+	static constexpr size_type huge_page_size = 2u * 1024u * 1024u;
+
+public: // construction
+	explicit basic_string_arena(
+		size_type chunk_size = default_chunk_size, bool huge_pages = false)
+		: chunk_size_(std::max(chunk_size, size_type{1}))
+		, huge_pages_(huge_pages)
+	{
+	}
+
+	basic_string_arena(const basic_string_arena &) = delete;
+
+	basic_string_arena(basic_string_arena && other) noexcept
+		: chunk_size_(other.chunk_size_)
+		, huge_pages_(other.huge_pages_)
+		, chunks_(std::move(other.chunks_))
+		, used_(other.used_)
+		, size_(other.size_)
+	{
+		other.chunks_.clear();
+		other.used_ = 0u;
+		other.size_ = 0u;
+	}
+
+	~basic_string_arena() { release(); }
+
+public: // assignment
+	basic_string_arena & operator=(const basic_string_arena &) = delete;
+
+	basic_string_arena & operator=(basic_string_arena && other) noexcept
+	{
+		if (this != &other) {
+			release();
+			chunk_size_ = other.chunk_size_;
+			huge_pages_ = other.huge_pages_;
+			chunks_ = std::move(other.chunks_);
+			used_ = other.used_;
+			size_ = other.size_;
+			other.chunks_.clear();
+			other.used_ = 0u;
+			other.size_ = 0u;
+		}
+		return *this;
+	}
+
+public: // capacity
+	/// Number of characters handed out since the last reset.
+	size_type size() const noexcept { return size_; }
+
+	/// Number of characters held in all chunks.
+	size_type capacity() const noexcept
+	{
+		size_type n = 0u;
+		for (const auto & c : chunks_)
+			n += c.size;
+		return n;
+	}
+
+public: // operations
+	/// Returns uninitialized storage for `n` characters.
+	CharT * allocate(size_type n)
+	{
+		if (chunks_.empty() || (chunks_.back().size - used_ < n)) {
+			if (!chunks_.empty() && (n > chunk_size_)) {
+				CharT * p = insert_chunk(n);
+				size_ += n;
+				return p;
+			}
+			grow(n);
+		}
+		CharT * p = chunks_.back().data + used_;
+		used_ += n;
+		size_ += n;
+		return p;
+	}
+
+	/// Copies the content of the specified view into the arena.
+	view_type store(view_type v)
+	{
+		if (v.size() == 0u)
+			return view_type{empty(), 0u};
+		CharT * p = allocate(v.size());
+		traits_type::copy(p, v.data(), v.size());
+		return view_type{p, v.size()};
+	}
+
+	/// Invalidates all stored views. The first chunk is kept for reuse.
+	void reset() noexcept
+	{
+		while (chunks_.size() > 1u) {
+			free_chunk(chunks_.back());
+			chunks_.pop_back();
+		}
+		used_ = 0u;
+		size_ = 0u;
+	}
+
+	/// Invalidates all stored views and returns all memory.
+	void release() noexcept
+	{
+		for (auto & c : chunks_)
+			free_chunk(c);
+		chunks_.clear();
+		used_ = 0u;
+		size_ = 0u;
+	}
+
+	void swap(basic_string_arena & other) noexcept
+	{
+		std::swap(chunk_size_, other.chunk_size_);
+		std::swap(huge_pages_, other.huge_pages_);
+		chunks_.swap(other.chunks_);
+		std::swap(used_, other.used_);
+		std::swap(size_, other.size_);
+	}
+
+private:
+	struct chunk {
+		CharT * data;
+		size_type size;
+		bool mapped;
+	};
+
+	static const CharT * empty() noexcept
+	{
+		static const CharT c{};
+		return &c;
+	}
+
+	void grow(size_type n)
+	{
+		chunks_.reserve(chunks_.size() + 1u);
+		chunks_.push_back(make_chunk(std::max(n, chunk_size_)));
+		used_ = 0u;
+	}
+
+	// oversized requests get a chunk of their own, it is placed before the
+	// current chunk, whose free space remains available for later requests
+	CharT * insert_chunk(size_type n)
+	{
+		chunks_.reserve(chunks_.size() + 1u);
+		chunks_.insert(chunks_.end() - 1, make_chunk(n));
+		return chunks_[chunks_.size() - 2u].data;
+	}
+
+	chunk make_chunk(size_type n)
+	{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		if (huge_pages_) {
+			size_type bytes = n * sizeof(CharT);
+			bytes = (bytes + huge_page_size - 1u) / huge_page_size * huge_page_size;
+			void * p = ::mmap(
+				nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p != MAP_FAILED) {
+				::madvise(p, bytes, MADV_HUGEPAGE);
+				return chunk{static_cast<CharT *>(p), bytes / sizeof(CharT), true};
+			}
+		}
+#endif
+		return chunk{new CharT[n], n, false};
+	}
+
+	static void free_chunk(chunk & c) noexcept
+	{
+#if defined(__linux__)
+		if (c.mapped) {
+			::munmap(c.data, c.size * sizeof(CharT));
+			return;
+		}
+#endif
+		delete[] c.data;
+	}
+
+private:
+	size_type chunk_size_;
+	bool huge_pages_;
+	std::vector<chunk> chunks_;
+	size_type used_ = 0u; // used characters within the last chunk
+	size_type size_ = 0u;
+};
+
+template <class CharT, class Traits>
+constexpr typename basic_string_arena<CharT, Traits>::size_type
+	basic_string_arena<CharT, Traits>::default_chunk_size;
+
+template <class CharT, class Traits>
+constexpr typename basic_string_arena<CharT, Traits>::size_type
+	basic_string_arena<CharT, Traits>::huge_page_size;
+
+// default types
+using string_arena = basic_string_arena<char>;
+}
+}
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef BACKPORT__CPP11__STRING_SEARCHER__HPP
+#define BACKPORT__CPP11__STRING_SEARCHER__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include <iterator>
+#include <type_traits>
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// Substring search with a needle prepared once and used for many searches.
+///
+/// For `char` the candidates are located 16 positions at a time by comparing the
+/// first and the last character of the needle with SSE2, only positions where both
+/// match are compared completely. Otherwise, and for other character types, the
+/// first character is located with `traits_type::find`.
+///
+/// The searcher refers to the needle, which has to outlive it. No memory is
+/// allocated.
+///
+template <class CharT, class Traits = std::char_traits<CharT>> class basic_string_searcher
+{
+public:
+	using view_type = basic_string_view<CharT, Traits>;
+	using traits_type = Traits;
+	using size_type = std::size_t;
+
+public: // construction
+	explicit basic_string_searcher(view_type needle) noexcept
+		: needle_(needle)
+	{
+	}
+
+public: // access
+	view_type needle() const noexcept { return needle_; }
+
+public: // operations
+	/// Position of the first occurrence at or after `pos`, `view_type::npos` if none.
+	/// An empty needle is found at `pos`, as by `basic_string_view::find`.
+	size_type find(view_type haystack, size_type pos = 0u) const noexcept
+	{
+		const size_type n = needle_.size();
+		if ((pos > haystack.size()) || (n > haystack.size() - pos))
+			return view_type::npos;
+		if (n == 0u)
+			return pos;
+		return find(haystack, pos, vectorized{});
+	}
+
+private:
+	using vectorized = std::integral_constant<bool,
+		std::is_same<CharT, char>::value
+			&& std::is_same<Traits, std::char_traits<char>>::value>;
+
+	size_type find(view_type haystack, size_type pos, std::false_type) const noexcept
+	{
+		const CharT * const h = haystack.data();
+		const size_type n = needle_.size();
+		const size_type last = haystack.size() - n; // last possible position
+		while (pos <= last) {
+			const CharT * p = traits_type::find(h + pos, last - pos + 1u, needle_[0]);
+			if (!p)
+				return view_type::npos;
+			pos = static_cast<size_type>(p - h);
+			if (traits_type::compare(p + 1, needle_.data() + 1, n - 1u) == 0)
+				return pos;
+			++pos;
+		}
+		return view_type::npos;
+	}
+
+	size_type find(view_type haystack, size_type pos, std::true_type) const noexcept
+	{
+		if (needle_.size() == 1u)
+			return haystack.find(needle_[0], pos);
+		return detail::search_chars(
+			haystack.data(), haystack.size(), pos, needle_.data(), needle_.size());
+	}
+
+private:
+	view_type needle_;
+};
+
+/// Handling of overlapping matches while enumerating all occurrences.
+enum class overlapping_matches { skip, keep };
+
+///
+/// Lazy range of the positions of all occurrences of a needle, result of `find_all`.
+///
+/// The search continues from the previous match with the same prepared searcher.
+/// Without overlapping matches it continues after the end of the previous match,
+/// so that dense matches keep the scan linear.
+///
+template <class CharT, class Traits> class basic_find_all_range
+{
+public:
+	using view_type = basic_string_view<CharT, Traits>;
+	using searcher_type = basic_string_searcher<CharT, Traits>;
+	using size_type = std::size_t;
+
+	class const_iterator
+	{
+		friend class basic_find_all_range;
+
+	public:
+		using difference_type = std::ptrdiff_t;
+		using value_type = size_type;
+		using pointer = const size_type *;
+		using reference = const size_type &;
+		using iterator_category = std::forward_iterator_tag;
+
+	public: // construction
+		const_iterator() noexcept = default;
+
+	public: // comparison operators
+		bool operator==(const const_iterator & other) const noexcept
+		{
+			return pos_ == other.pos_;
+		}
+
+		bool operator!=(const const_iterator & other) const noexcept
+		{
+			return !(*this == other);
+		}
+
+	public: // modifiers
+		const_iterator & operator++() noexcept
+		{
+			pos_ = range_->searcher_.find(range_->haystack_, pos_ + range_->step_);
+			return *this;
+		}
+
+		const_iterator operator++(int) noexcept
+		{
+			const_iterator i{*this};
+			++(*this);
+			return i;
+		}
+
+	public: // access
+		reference operator*() const noexcept { return pos_; }
+
+		pointer operator->() const noexcept { return &pos_; }
+
+	private: // construction
+		explicit const_iterator(const basic_find_all_range * range) noexcept
+			: range_(range)
+			, pos_(range->searcher_.find(range->haystack_))
+		{
+		}
+
+	private:
+		const basic_find_all_range * range_ = nullptr;
+		size_type pos_ = view_type::npos;
+	};
+
+	using iterator = const_iterator;
+
+public: // construction
+	basic_find_all_range(
+		view_type haystack, const searcher_type & searcher, overlapping_matches overlapping)
+		: haystack_(haystack)
+		, searcher_(searcher)
+		, step_(((overlapping == overlapping_matches::keep) || searcher.needle().empty())
+				  ? 1u
+				  : searcher.needle().size())
+	{
+	}
+
+public: // iterators
+	const_iterator begin() const noexcept { return const_iterator{this}; }
+
+	const_iterator end() const noexcept { return const_iterator{}; }
+
+private:
+	view_type haystack_;
+	searcher_type searcher_;
+	size_type step_; // from a match to the next possible one
+};
+
+/// All occurrences of the needle within the haystack, an empty needle is found at
+/// every position.
+template <class CharT, class Traits>
+basic_find_all_range<CharT, Traits> find_all(basic_string_view<CharT, Traits> haystack,
+	detail::non_deduced_view<CharT, Traits> needle,
+	overlapping_matches overlapping = overlapping_matches::skip)
+{
+	return {haystack, basic_string_searcher<CharT, Traits>{needle}, overlapping};
+}
+
+/// All occurrences of the needle of a prepared searcher within the haystack.
+template <class CharT, class Traits>
+basic_find_all_range<CharT, Traits> find_all(basic_string_view<CharT, Traits> haystack,
+	const basic_string_searcher<CharT, Traits> & searcher,
+	overlapping_matches overlapping = overlapping_matches::skip)
+{
+	return {haystack, searcher, overlapping};
+}
+
+// default types
+using string_searcher = basic_string_searcher<char>;
+}
+}
+
+#endif
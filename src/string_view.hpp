@@ -30,11 +30,104 @@
 #include <stdexcept>
 #include <string>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace backport
 {
 namespace cpp11
 {
+namespace detail
+{
+inline unsigned count_trailing_zeros(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__)
+	return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+	unsigned n = 0u;
+	for (; !(x & 1u); x >>= 1)
+		++n;
+	return n;
+#endif
+}
+
+/// Number of occurrences of `c` within the `n` characters at `p`.
+inline std::size_t count_char(const char * p, std::size_t n, char c) noexcept
+{
+	std::size_t total = 0u;
+#if defined(__SSE2__)
+	// byte wise counters (a match subtracts -1), summed up before they overflow
+	const __m128i needle = _mm_set1_epi8(c);
+	const __m128i zero = _mm_setzero_si128();
+	while (n >= 64u) {
+		const std::size_t blocks = std::min(n / 64u, std::size_t{63});
+		__m128i counters = zero;
+		for (std::size_t i = 0u; i < blocks; ++i, p += 64) {
+			const auto * v = reinterpret_cast<const __m128i *>(p);
+			counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_loadu_si128(v), needle));
+			counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_loadu_si128(v + 1), needle));
+			counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_loadu_si128(v + 2), needle));
+			counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_loadu_si128(v + 3), needle));
+		}
+		n -= blocks * 64u;
+		const __m128i sums = _mm_sad_epu8(counters, zero);
+		total += static_cast<std::size_t>(_mm_cvtsi128_si32(sums))
+			+ static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+	}
+#endif
+	for (; n > 0u; --n, ++p)
+		total += (*p == c) ? 1u : 0u;
+	return total;
+}
+
+///
+/// Position of the first occurrence of the needle `s` (`n` characters, at least 2)
+/// at or after `pos` within the `size` characters at `h`, `size_t(-1)` if none.
+///
+/// Candidates are located 16 positions at a time by comparing the first and the last
+/// character of the needle with SSE2, only positions where both match are compared
+/// completely.
+///
+inline std::size_t search_chars(const char * h, std::size_t size, std::size_t pos,
+	const char * s, std::size_t n) noexcept
+{
+	static constexpr std::size_t not_found = static_cast<std::size_t>(-1);
+	if ((pos > size) || (n > size - pos))
+		return not_found;
+#if defined(__SSE2__)
+	const __m128i first = _mm_set1_epi8(s[0]);
+	const __m128i last = _mm_set1_epi8(s[n - 1u]);
+
+	// the last character of the needle has to be within the haystack
+	for (; pos + n - 1u + 16u <= size; pos += 16u) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h + pos));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h + pos + n - 1u));
+		auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+			_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+		while (mask) {
+			const std::size_t i = pos + count_trailing_zeros(mask);
+			if (std::memcmp(h + i + 1u, s + 1u, n - 2u) == 0)
+				return i;
+			mask &= mask - 1u;
+		}
+	}
+#endif
+	for (; pos + n <= size; ++pos) {
+		const void * p = std::memchr(h + pos, s[0], size - n - pos + 1u);
+		if (!p)
+			return not_found;
+		pos = static_cast<std::size_t>(static_cast<const char *>(p) - h);
+		if (std::memcmp(h + pos + 1u, s + 1u, n - 1u) == 0)
+			return pos;
+	}
+	return not_found;
+}
+}
+
 ///
 /// Backport of `std::string_view` for C++11.
 ///
@@ -238,6 +331,14 @@ public: // construction
 	{
 	}
 
+	/// Views the content of the string, no copy, no length computation.
+	template <class Allocator>
+	basic_string_view(const std::basic_string<CharT, Traits, Allocator> & s) noexcept
+		: ptr_(s.data())
+		, size_(s.size())
+	{
+	}
+
 public: // assignment
 	basic_string_view & operator=(const basic_string_view &) = default;
 
@@ -505,6 +606,52 @@ public: // operations
 		return find_last_not_of(basic_string_view{s}, pos);
 	}
 
+	/// Number of occurrences of the character, 64 characters at a time for `char`.
+	size_type count(CharT c) const noexcept { return count(c, vectorized{}); }
+
+	/// Number of non overlapping occurrences of the view, an empty view is counted at
+	/// every position (`size() + 1`).
+	size_type count(basic_string_view v) const noexcept
+	{
+		if (v.empty())
+			return size_ + 1u;
+		if (v.size() == 1u)
+			return count(v[0]);
+		size_type n = 0u;
+		for (size_type pos = search(v, 0u, vectorized{}); pos != npos;
+			 pos = search(v, pos + v.size(), vectorized{}))
+			++n;
+		return n;
+	}
+
+private:
+	using vectorized = std::integral_constant<bool,
+		std::is_same<CharT, char>::value
+			&& std::is_same<Traits, std::char_traits<char>>::value>;
+
+	size_type count(CharT c, std::true_type) const noexcept
+	{
+		return detail::count_char(ptr_, size_, c);
+	}
+
+	size_type count(CharT c, std::false_type) const noexcept
+	{
+		size_type n = 0u;
+		for (size_type i = 0u; i < size_; ++i)
+			n += traits_type::eq(ptr_[i], c) ? 1u : 0u;
+		return n;
+	}
+
+	size_type search(basic_string_view v, size_type pos, std::true_type) const noexcept
+	{
+		return detail::search_chars(ptr_, size_, pos, v.data(), v.size());
+	}
+
+	size_type search(basic_string_view v, size_type pos, std::false_type) const noexcept
+	{
+		return (pos > size_) ? npos : find(v, pos);
+	}
+
 private:
 	const_pointer ptr_ = nullptr;
 	size_type size_ = 0u;
@@ -515,19 +662,61 @@ constexpr
 	typename basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::npos;
 
 // comparison operators
+//
+// The overloads using `detail::non_deduced_view` accept everything implicitly convertible to
+// a view on one side, e.g. `std::basic_string` (no copy) or `const CharT *`.
+// Equality checks the sizes first, the data is not looked at if they differ.
+
+namespace detail
+{
+template <class T> struct identity {
+	using type = T;
+};
+
+template <class CharT, class Traits>
+using non_deduced_view = typename identity<basic_string_view<CharT, Traits>>::type;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator==(const basic_string_view<CharT, Traits> & a,
+	const basic_string_view<CharT, Traits> & b) noexcept
+{
+	return (a.size() == b.size()) && (a.compare(b) == 0);
+}
 
 template <class CharT, class Traits = std::char_traits<CharT>>
 constexpr bool operator==(const basic_string_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return (a.size() == b.size()) && (a.compare(b) == 0);
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator==(const detail::non_deduced_view<CharT, Traits> & a,
+	const basic_string_view<CharT, Traits> & b) noexcept
+{
+	return (a.size() == b.size()) && (a.compare(b) == 0);
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator!=(const basic_string_view<CharT, Traits> & a,
 	const basic_string_view<CharT, Traits> & b) noexcept
 {
-	return a.compare(b) == 0;
+	return (a.size() != b.size()) || (a.compare(b) != 0);
 }
 
 template <class CharT, class Traits = std::char_traits<CharT>>
 constexpr bool operator!=(const basic_string_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return (a.size() != b.size()) || (a.compare(b) != 0);
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator!=(const detail::non_deduced_view<CharT, Traits> & a,
 	const basic_string_view<CharT, Traits> & b) noexcept
 {
-	return a.compare(b) != 0;
+	return (a.size() != b.size()) || (a.compare(b) != 0);
 }
 
 template <class CharT, class Traits = std::char_traits<CharT>>
@@ -537,8 +726,36 @@ constexpr bool operator<(const basic_string_view<CharT, Traits> & a,
 	return a.compare(b) < 0;
 }
 
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator<(const basic_string_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.compare(b) < 0;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator<(const detail::non_deduced_view<CharT, Traits> & a,
+	const basic_string_view<CharT, Traits> & b) noexcept
+{
+	return a.compare(b) < 0;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator>(const basic_string_view<CharT, Traits> & a,
+	const basic_string_view<CharT, Traits> & b) noexcept
+{
+	return a.compare(b) > 0;
+}
+
 template <class CharT, class Traits = std::char_traits<CharT>>
 constexpr bool operator>(const basic_string_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.compare(b) > 0;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator>(const detail::non_deduced_view<CharT, Traits> & a,
 	const basic_string_view<CharT, Traits> & b) noexcept
 {
 	return a.compare(b) > 0;
@@ -548,29 +765,110 @@ template <class CharT, class Traits = std::char_traits<CharT>>
 constexpr bool operator<=(const basic_string_view<CharT, Traits> & a,
 	const basic_string_view<CharT, Traits> & b) noexcept
 {
-	return !(a > b);
+	return a.compare(b) <= 0;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator<=(const basic_string_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.compare(b) <= 0;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator<=(const detail::non_deduced_view<CharT, Traits> & a,
+	const basic_string_view<CharT, Traits> & b) noexcept
+{
+	return a.compare(b) <= 0;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator>=(const basic_string_view<CharT, Traits> & a,
+	const basic_string_view<CharT, Traits> & b) noexcept
+{
+	return a.compare(b) >= 0;
 }
 
 template <class CharT, class Traits = std::char_traits<CharT>>
 constexpr bool operator>=(const basic_string_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.compare(b) >= 0;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+constexpr bool operator>=(const detail::non_deduced_view<CharT, Traits> & a,
 	const basic_string_view<CharT, Traits> & b) noexcept
 {
-	return !(a < b);
+	return a.compare(b) >= 0;
 }
 
 // string
 template <class CharT, class Traits = std::char_traits<CharT>>
 constexpr std::basic_string<CharT, Traits> to_string(basic_string_view<CharT, Traits> v)
 {
-	return std::basic_string<CharT, Traits>{v.begin(), v.end()};
+	return std::basic_string<CharT, Traits>(v.data(), v.size());
+}
+
+/// Replaces the content of `s` by the view, reusing the capacity of `s`.
+template <class CharT, class Traits, class Allocator>
+std::basic_string<CharT, Traits, Allocator> & assign_to(
+	std::basic_string<CharT, Traits, Allocator> & s, basic_string_view<CharT, Traits> v)
+{
+	return s.assign(v.data(), v.size());
+}
+
+/// Appends the view to `s`, reusing the capacity of `s`.
+template <class CharT, class Traits, class Allocator>
+std::basic_string<CharT, Traits, Allocator> & append_to(
+	std::basic_string<CharT, Traits, Allocator> & s, basic_string_view<CharT, Traits> v)
+{
+	return s.append(v.data(), v.size());
 }
 
 // stream operators
+namespace detail
+{
+template <class CharT, class Traits>
+bool pad(std::basic_streambuf<CharT, Traits> & buf, CharT fill, std::streamsize n)
+{
+	for (; n > 0; --n)
+		if (Traits::eq_int_type(buf.sputc(fill), Traits::eof()))
+			return false;
+	return true;
+}
+}
+
+/// Formatted output, writes directly to the stream buffer without a temporary string.
 template <class CharT, class Traits>
 std::basic_ostream<CharT, Traits> & operator<<(
 	std::basic_ostream<CharT, Traits> & os, basic_string_view<CharT, Traits> v)
 {
-	return os << to_string(v);
+	typename std::basic_ostream<CharT, Traits>::sentry sentry{os};
+	if (!sentry)
+		return os;
+
+	const std::streamsize size = v.size();
+	const std::streamsize padding = (os.width() > size) ? (os.width() - size) : 0;
+	const bool left = (os.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+
+	bool ok = true;
+	try {
+		auto & buf = *os.rdbuf();
+		if (!left)
+			ok = detail::pad(buf, os.fill(), padding);
+		if (ok)
+			ok = buf.sputn(v.data(), size) == size;
+		if (ok && left)
+			ok = detail::pad(buf, os.fill(), padding);
+	} catch (...) {
+		os.setstate(std::ios_base::badbit);
+		return os;
+	}
+	if (!ok)
+		os.setstate(std::ios_base::badbit);
+	os.width(0);
+	return os;
 }
 
 // default types
@@ -0,0 +1,153 @@
+#ifndef BACKPORT__CPP11__STRUCTURAL_INDEX__HPP
+#define BACKPORT__CPP11__STRUCTURAL_INDEX__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+#include "char_set.hpp"
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace backport
+{
+namespace cpp11
+{
+namespace detail
+{
+/// Bit `i` is set if `p[i] == c`, for the 64 bytes starting at `p`.
+inline std::uint64_t equal_mask64(const char * p, char c) noexcept
+{
+	std::uint64_t mask = 0u;
+#if defined(__SSE2__)
+	const __m128i needle = _mm_set1_epi8(c);
+	for (unsigned k = 0u; k < 4u; ++k) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16u * k));
+		const auto bits = _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+		mask |= std::uint64_t{static_cast<std::uint16_t>(bits)} << (16u * k);
+	}
+#else
+	for (unsigned i = 0u; i < 64u; ++i)
+		if (p[i] == c)
+			mask |= std::uint64_t{1} << i;
+#endif
+	return mask;
+}
+}
+
+///
+/// Locates all characters of a set within a view, writing their offsets into an array.
+///
+/// The data is processed in blocks of 64 bytes: a bit mask of the matching bytes
+/// is computed for the whole block first, then the offsets are extracted from
+/// the mask. With SSE2 and up to 16 characters in the set, the masks are computed
+/// with vector comparisons, otherwise by table lookup.
+///
+/// Tokenizers are then able to walk the offsets instead of searching repeatedly.
+///
+class structural_scanner
+{
+public:
+	using size_type = std::size_t;
+
+public: // constants
+	static constexpr size_type max_vector_chars = 16u;
+
+public: // construction
+	explicit structural_scanner(const char_set & set) noexcept
+		: set_(set)
+	{
+		for (unsigned c = 0u; c < 256u; ++c) {
+			if (!set.contains(static_cast<char>(c)))
+				continue;
+			if (count_ == max_vector_chars) {
+				count_ = max_vector_chars + 1u; // too many for comparisons
+				break;
+			}
+			chars_[count_++] = static_cast<char>(c);
+		}
+	}
+
+public: // operations
+	/// Writes the offsets of the matching characters of `s`, starting at `pos`, to `out`.
+	///
+	/// Returns the number of offsets written, at most `capacity`. If the capacity is
+	/// exhausted, the scan continues with `pos` set to one past the last offset.
+	/// Throws `std::length_error` for views which do not fit 32 bit offsets.
+	size_type scan(
+		string_view s, std::uint32_t * out, size_type capacity, size_type pos = 0) const
+	{
+		if (s.size() > std::numeric_limits<std::uint32_t>::max())
+			throw std::length_error{"structural_scanner: view too large"};
+
+		size_type n = 0u;
+		for (; pos < s.size(); pos += 64u) {
+			const size_type len = std::min(s.size() - pos, size_type{64});
+			std::uint64_t mask = block_mask(s.data() + pos, len);
+			for (; mask; mask &= mask - 1u) {
+				if (n == capacity)
+					return n;
+				out[n++] = static_cast<std::uint32_t>(pos + detail::count_trailing_zeros(mask));
+			}
+		}
+		return n;
+	}
+
+private:
+	/// Bit `i` is set if `p[i]` is contained in the set, `n` at most 64.
+	std::uint64_t block_mask(const char * p, size_type n) const noexcept
+	{
+#if defined(__SSE2__)
+		if ((n == 64u) && (count_ <= max_vector_chars)) {
+			std::uint64_t mask = 0u;
+			for (unsigned k = 0u; k < 4u; ++k) {
+				const __m128i v
+					= _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16u * k));
+				__m128i hits = _mm_setzero_si128();
+				for (unsigned j = 0u; j < count_; ++j)
+					hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8(chars_[j])));
+				const auto bits = static_cast<std::uint16_t>(_mm_movemask_epi8(hits));
+				mask |= std::uint64_t{bits} << (16u * k);
+			}
+			return mask;
+		}
+#endif
+		std::uint64_t mask = 0u;
+		for (size_type i = 0u; i < n; ++i)
+			if (set_.contains(p[i]))
+				mask |= std::uint64_t{1} << i;
+		return mask;
+	}
+
+private:
+	char_set set_;
+	char chars_[max_vector_chars] = {};
+	unsigned count_ = 0u;
+};
+}
+}
+
+#endif
@@ -1,4 +1,26 @@
 #include "string_view.hpp"
+#include "string_arena.hpp"
+#include "zstring_view.hpp"
+#include "mapped_file.hpp"
+#include "ring_buffer.hpp"
+#include "segmented_view.hpp"
+#include "stream_searcher.hpp"
+#include "line_reader.hpp"
+#include "gather_writer.hpp"
+#include "file_scanner.hpp"
+#include "char_set.hpp"
+#include "split.hpp"
+#include "structural_index.hpp"
+#include "csv_reader.hpp"
+#include "charconv.hpp"
+#include "iso8601.hpp"
+#include "concat.hpp"
+#include "string_searcher.hpp"
+#include "replace.hpp"
+#include <iomanip>
+#include <sstream>
+#include <cmath>
+#include <cstdlib>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
@@ -28,6 +50,14 @@ TEST_CASE("from C string")
 	static const char * s = "Hello World";
 	CHECK_NOTHROW(string_view v(s));
 }
+
+TEST_CASE("from std::string")
+{
+	const std::string s{"Hello World"};
+	const string_view v = s;
+	CHECK(v.data() == s.data());
+	CHECK(v.size() == s.size());
+}
 TEST_SUITE_END();
 
 TEST_SUITE("assignment");
@@ -778,5 +808,1916 @@ TEST_CASE("operator equal")
 	CHECK_FALSE(d == c);
 	CHECK(d == d);
 }
+
+TEST_CASE("operator equal mixed")
+{
+	const string_view v{"foobar"};
+	const std::string s{"foobar"};
+	const std::string t{"Foobar"};
+
+	CHECK(v == s);
+	CHECK(s == v);
+	CHECK(v == "foobar");
+	CHECK("foobar" == v);
+	CHECK_FALSE(v == t);
+	CHECK_FALSE(t == v);
+	CHECK_FALSE(v == "foo");
+	CHECK_FALSE("foo" == v);
+
+	CHECK(v != t);
+	CHECK(t != v);
+	CHECK(v != "foo");
+	CHECK("foo" != v);
+	CHECK_FALSE(v != s);
+	CHECK_FALSE("foobar" != v);
+}
+
+TEST_CASE("operator less and greater mixed")
+{
+	const string_view v{"bar"};
+	const std::string s{"foo"};
+
+	CHECK(v < s);
+	CHECK(s > v);
+	CHECK(v <= s);
+	CHECK(s >= v);
+	CHECK(v < "baz");
+	CHECK("baz" > v);
+	CHECK(v <= "bar");
+	CHECK("bar" >= v);
+	CHECK_FALSE(v > "bar");
+	CHECK_FALSE("ba" > v);
+}
+
+TEST_CASE("to_string")
+{
+	CHECK(to_string(string_view{"Hello World"}) == "Hello World");
+	CHECK(to_string(string_view{"Hello World"}.substr(6)) == "World");
+	CHECK(to_string(string_view{}).empty());
+}
+
+TEST_CASE("assign_to")
+{
+	std::string s;
+	s.reserve(32);
+	const auto capacity = s.capacity();
+	assign_to(s, string_view{"Hello"});
+	CHECK(s == "Hello");
+	assign_to(s, string_view{"World"}.substr(1));
+	CHECK(s == "orld");
+	CHECK(s.capacity() == capacity);
+}
+
+TEST_CASE("append_to")
+{
+	std::string s{"Hello"};
+	append_to(append_to(s, string_view{" "}), string_view{"World!"}.substr(0, 5));
+	CHECK(s == "Hello World");
+}
+
+TEST_CASE("stream output")
+{
+	std::ostringstream os;
+	os << string_view{"Hello"} << ' ' << string_view{"World"};
+	CHECK(os.str() == "Hello World");
+}
+
+TEST_CASE("stream output padding right")
+{
+	std::ostringstream os;
+	os << std::setw(8) << std::setfill('.') << string_view{"foo"} << string_view{"bar"};
+	CHECK(os.str() == ".....foobar");
+}
+
+TEST_CASE("stream output padding left")
+{
+	std::ostringstream os;
+	os << std::left << std::setw(8) << string_view{"foo"} << '|';
+	CHECK(os.str() == "foo     |");
+}
+
+TEST_CASE("stream output width smaller than size")
+{
+	std::ostringstream os;
+	os << std::setw(2) << string_view{"foo"};
+	CHECK(os.str() == "foo");
+	CHECK(os.width() == 0);
+}
+
+TEST_CASE("stream output to failed stream")
+{
+	std::ostringstream os;
+	os.setstate(std::ios_base::failbit);
+	os << string_view{"foo"};
+	CHECK(os.str().empty());
+}
+TEST_SUITE_END();
+
+TEST_SUITE("string_arena");
+TEST_CASE("store copies content")
+{
+	string_arena arena;
+	std::string s{"Hello World"};
+	const string_view v = arena.store(string_view{s.c_str()});
+	s[0] = 'J';
+	CHECK(v.size() == 11u);
+	CHECK(std::strncmp(v.data(), "Hello World", v.size()) == 0);
+	CHECK(arena.size() == 11u);
+}
+
+TEST_CASE("store empty")
+{
+	string_arena arena;
+	const string_view v = arena.store(string_view{""});
+	CHECK(v.empty());
+	CHECK(v.data() != nullptr);
+	CHECK(arena.capacity() == 0u);
+}
+
+TEST_CASE("store spanning chunks")
+{
+	string_arena arena{8};
+	const string_view a = arena.store(string_view{"Hello"});
+	const string_view b = arena.store(string_view{"World"});
+	const string_view c = arena.store(string_view{"the quick brown fox"});
+	CHECK(a == string_view{"Hello"});
+	CHECK(b == string_view{"World"});
+	CHECK(c == string_view{"the quick brown fox"});
+	CHECK(arena.capacity() == 8u + 8u + 19u);
+}
+
+TEST_CASE("store after oversized keeps using the current chunk")
+{
+	string_arena arena{8};
+	const string_view a = arena.store(string_view{"Hello"});
+	const string_view b = arena.store(string_view{"the quick brown fox"});
+	const string_view c = arena.store(string_view{"foo"});
+	CHECK(a == string_view{"Hello"});
+	CHECK(b == string_view{"the quick brown fox"});
+	CHECK(c == string_view{"foo"});
+	CHECK(c.data() == a.data() + a.size());
+	CHECK(arena.size() == 5u + 19u + 3u);
+	CHECK(arena.capacity() == 8u + 19u);
+}
+
+TEST_CASE("reset keeps first chunk")
+{
+	string_arena arena{8};
+	arena.store(string_view{"Hello"});
+	arena.store(string_view{"World"});
+	arena.reset();
+	CHECK(arena.size() == 0u);
+	CHECK(arena.capacity() == 8u);
+	const string_view v = arena.store(string_view{"foo"});
+	CHECK(v == string_view{"foo"});
+}
+
+TEST_CASE("move construction")
+{
+	string_arena a;
+	const string_view v = a.store(string_view{"Hello"});
+	string_arena b{std::move(a)};
+	CHECK(a.capacity() == 0u);
+	CHECK(b.size() == 5u);
+	CHECK(v == string_view{"Hello"});
+}
+
+TEST_CASE("huge pages")
+{
+	string_arena arena{16, true};
+	const string_view v = arena.store(string_view{"Hello World"});
+	CHECK(v == string_view{"Hello World"});
+	CHECK(arena.capacity() >= 16u);
+}
+TEST_SUITE_END();
+
+TEST_SUITE("zstring_view");
+TEST_CASE("default")
+{
+	const zstring_view v;
+	CHECK(v.empty());
+	CHECK(v.c_str() != nullptr);
+	CHECK(v.c_str()[0] == '\0');
+}
+
+TEST_CASE("from C string")
+{
+	const zstring_view v{"Hello World"};
+	CHECK(v.size() == 11u);
+	CHECK(std::strcmp(v.c_str(), "Hello World") == 0);
+}
+
+TEST_CASE("from C string and count")
+{
+	static const char * s = "Hello World";
+	const zstring_view v{s + 6, 5};
+	CHECK(v.size() == 5u);
+	CHECK(std::strcmp(v.c_str(), "World") == 0);
+}
+
+TEST_CASE("from std::string")
+{
+	const std::string s{"Hello World"};
+	const zstring_view v{s};
+	CHECK(v.c_str() == s.c_str());
+	CHECK(v.size() == s.size());
+}
+
+TEST_CASE("conversion to string_view")
+{
+	const zstring_view z{"Hello World"};
+	const string_view v = z;
+	CHECK(v.data() == z.data());
+	CHECK(v.size() == z.size());
+	CHECK(z == zstring_view{"Hello World"});
+	CHECK(z.view() == "Hello World");
+}
+
+TEST_CASE("substr")
+{
+	const zstring_view v{"Hello World"};
+	const zstring_view a = v.substr(6);
+	CHECK(std::strcmp(a.c_str(), "World") == 0);
+	CHECK(v.substr(v.size()).empty());
+	CHECK_THROWS(v.substr(v.size() + 1));
+	const string_view b = v.substr(0, 5);
+	CHECK(b == "Hello");
+}
+
+TEST_CASE("iterators")
+{
+	const zstring_view v{"Hello"};
+	CHECK(std::string(v.begin(), v.end()) == "Hello");
+	CHECK(std::string(v.rbegin(), v.rend()) == "olleH");
+}
+
+TEST_CASE("remove_prefix")
+{
+	zstring_view v{"Hello World"};
+	v.remove_prefix(6);
+	CHECK(std::strcmp(v.c_str(), "World") == 0);
+}
+
+TEST_CASE("comparison")
+{
+	const zstring_view a{"bar"};
+	const zstring_view b{"foo"};
+	CHECK(a < b);
+	CHECK(b > a);
+	CHECK(a <= a);
+	CHECK(a >= a);
+	CHECK(a != b);
+	CHECK_FALSE(a == b);
+}
+
+TEST_CASE("mixed comparison")
+{
+	const zstring_view z{"foo"};
+	const std::string s{"foo"};
+	CHECK(z == "foo");
+	CHECK("foo" == z);
+	CHECK(z == s);
+	CHECK(s == z);
+	CHECK(z == string_view{"foo"});
+	CHECK(string_view{"foo"} == z);
+	CHECK(z != "bar");
+	CHECK("bar" != z);
+	CHECK(z > "bar");
+	CHECK("bar" < z);
+	CHECK(z >= s);
+	CHECK(s <= z);
+	CHECK(z < std::string{"fooo"});
+	CHECK_FALSE(z < "foo");
+}
+TEST_SUITE_END();
+
+namespace
+{
+/// Temporary file, removed at the end of the test.
+struct temporary_file {
+	temporary_file(const std::string & content = std::string{})
+	{
+		char tmpl[] = "/tmp/backport-test-XXXXXX";
+		const int fd = ::mkstemp(tmpl);
+		REQUIRE(fd >= 0);
+		::close(fd);
+		path = tmpl;
+		append(content);
+	}
+
+	~temporary_file() { ::unlink(path.c_str()); }
+
+	void append(const std::string & content)
+	{
+		const int fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+		REQUIRE(fd >= 0);
+		REQUIRE(::write(fd, content.data(), content.size())
+			== static_cast<ssize_t>(content.size()));
+		::close(fd);
+	}
+
+	std::string path;
+};
+}
+
+TEST_SUITE("mapped_file");
+TEST_CASE("default")
+{
+	const mapped_file f;
+	CHECK_FALSE(f.is_open());
+	CHECK(f.empty());
+	CHECK(f.view().empty());
+}
+
+TEST_CASE("map file")
+{
+	temporary_file tmp{"the quick brown fox jumps over the lazy dog"};
+	const mapped_file f{tmp.path, mapped_file::sequential | mapped_file::populate};
+	CHECK(f.is_open());
+	CHECK(f.size() == 43u);
+	CHECK(f.view() == "the quick brown fox jumps over the lazy dog");
+	CHECK(f.view().find("fox") == 16u);
+}
+
+TEST_CASE("map empty file")
+{
+	temporary_file tmp;
+	const mapped_file f{tmp.path, mapped_file::willneed | mapped_file::huge_pages};
+	CHECK(f.is_open());
+	CHECK(f.empty());
+	CHECK(f.view() == "");
+}
+
+TEST_CASE("map file not existing")
+{
+	CHECK_THROWS_AS(mapped_file{"/nonexistent/file"}, const std::system_error &);
+}
+
+TEST_CASE("remap grown file")
+{
+	temporary_file tmp;
+	mapped_file f{tmp.path};
+	CHECK_FALSE(f.remap());
+	tmp.append("Hello");
+	CHECK(f.remap());
+	CHECK(f.view() == "Hello");
+	tmp.append(" World");
+	CHECK(f.remap());
+	CHECK(f.view() == "Hello World");
+	CHECK_FALSE(f.remap());
+}
+
+TEST_CASE("move")
+{
+	temporary_file tmp{"Hello"};
+	mapped_file a{tmp.path};
+	mapped_file b{std::move(a)};
+	CHECK_FALSE(a.is_open());
+	CHECK(b.view() == "Hello");
+	a = std::move(b);
+	CHECK(a.view() == "Hello");
+}
+TEST_SUITE_END();
+
+TEST_SUITE("mirrored_ring_buffer");
+TEST_CASE("capacity rounded up to page size")
+{
+	const mirrored_ring_buffer b{1};
+	CHECK(b.capacity() == static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)));
+	CHECK(b.empty());
+	CHECK(b.available() == b.capacity());
+}
+
+TEST_CASE("write and consume")
+{
+	mirrored_ring_buffer b{1};
+	CHECK(b.write(string_view{"Hello World"}) == 11u);
+	CHECK(b.view() == "Hello World");
+	b.consume(6);
+	CHECK(b.view() == "World");
+	b.consume(5);
+	CHECK(b.empty());
+}
+
+TEST_CASE("write more than available")
+{
+	mirrored_ring_buffer b{1};
+	const std::string s(b.capacity() + 10u, 'x');
+	CHECK(b.write(string_view{s}) == b.capacity());
+	CHECK(b.full());
+	CHECK(b.write(string_view{"y"}) == 0u);
+}
+
+TEST_CASE("data wrapping around is contiguous")
+{
+	mirrored_ring_buffer b{1};
+	const std::string s(b.capacity() - 5u, 'x');
+	b.write(string_view{s});
+	b.consume(s.size());
+	CHECK(b.write(string_view{"Hello World"}) == 11u);
+	const string_view v = b.view();
+	CHECK(v == "Hello World");
+	CHECK(v.find("World") == 6u);
+}
+
+TEST_CASE("read from file descriptor")
+{
+	int fds[2];
+	REQUIRE(::pipe(fds) == 0);
+	REQUIRE(::write(fds[1], "foo|bar", 7) == 7);
+	::close(fds[1]);
+
+	mirrored_ring_buffer b{1};
+	CHECK(b.read_from(fds[0]) == 7);
+	CHECK(b.read_from(fds[0]) == 0);
+	CHECK(b.view() == "foo|bar");
+	::close(fds[0]);
+}
+
+TEST_CASE("move")
+{
+	mirrored_ring_buffer a{1};
+	a.write(string_view{"Hello"});
+	mirrored_ring_buffer b{std::move(a)};
+	CHECK(a.capacity() == 0u);
+	CHECK(b.view() == "Hello");
+}
+TEST_SUITE_END();
+
+TEST_SUITE("segmented_view");
+TEST_CASE("default")
+{
+	const segmented_view v;
+	CHECK(v.empty());
+	CHECK(v.size() == 0u);
+	CHECK(v.begin() == v.end());
+	CHECK(v.find("foo") == segmented_view::npos);
+}
+
+TEST_CASE("size and element access")
+{
+	const std::vector<string_view> segments{"Hello", "", " Wo", "rld"};
+	const segmented_view v{segments};
+	CHECK(v.size() == 11u);
+	CHECK(v[0] == 'H');
+	CHECK(v[5] == ' ');
+	CHECK(v[7] == 'o');
+	CHECK(v[8] == 'r');
+	CHECK(v.back() == 'd');
+	CHECK_THROWS(v.at(11));
+}
+
+TEST_CASE("iteration")
+{
+	const std::vector<string_view> segments{"Hello", "", " Wo", "rld"};
+	const segmented_view v{segments};
+	CHECK(std::string(v.begin(), v.end()) == "Hello World");
+}
+
+TEST_CASE("substr")
+{
+	const std::vector<string_view> segments{"Hello", " Wo", "rld"};
+	const segmented_view v{segments};
+	CHECK(v.substr(3, 5) == "lo Wo");
+	CHECK(v.substr(5) == " World");
+	CHECK(v.substr(8) == "rld");
+	CHECK(v.substr(11).empty());
+	CHECK(v.substr(3).substr(3, 3) == "Wor");
+	CHECK_THROWS(v.substr(12));
+}
+
+TEST_CASE("copy")
+{
+	const std::vector<string_view> segments{"Hello", " Wo", "rld"};
+	const segmented_view v{segments};
+	char buf[20];
+	CHECK(v.copy(buf, 6, 3) == 6u);
+	CHECK(std::strncmp(buf, "lo Wor", 6) == 0);
+	CHECK(v.copy(buf, 20, 8) == 3u);
+	CHECK(std::strncmp(buf, "rld", 3) == 0);
+}
+
+TEST_CASE("compare")
+{
+	const std::vector<string_view> a{"Hel", "lo World"};
+	const std::vector<string_view> b{"Hello W", "orld"};
+	const std::vector<string_view> c{"Hello W", "orld!"};
+	CHECK(segmented_view{a} == segmented_view{b});
+	CHECK(segmented_view{a}.compare(segmented_view{c}) < 0);
+	CHECK(segmented_view{c}.compare(segmented_view{a}) > 0);
+	CHECK(segmented_view{a} == "Hello World");
+	CHECK(segmented_view{a} != "Hello Xorld");
+	CHECK(segmented_view{a}.compare("Hello Uorld") > 0);
+}
+
+TEST_CASE("find within segments")
+{
+	const std::vector<string_view> segments{
+		"the quick brown ", "fox jumps over", " the lazy dog"};
+	const segmented_view v{segments};
+	CHECK(v.find("quick") == 4u);
+	CHECK(v.find("fox") == 16u);
+	CHECK(v.find("the") == 0u);
+	CHECK(v.find("the", 1) == 31u);
+	CHECK(v.find("cat") == segmented_view::npos);
+	CHECK(v.find("", 5) == 5u);
+}
+
+TEST_CASE("find across segments")
+{
+	const std::array<string_view, 5> segments{
+		{"the quick br", "o", "wn f", "ox jumps", " over"}};
+	const segmented_view v{segments};
+	CHECK(v.find("brown") == 10u);
+	CHECK(v.find("brown fox") == 10u);
+	CHECK(v.find("s over") == 24u);
+	CHECK(v.find("x j", 17) == 18u);
+	CHECK(v.find("over!") == segmented_view::npos);
+	CHECK(v.find("brown", 11) == segmented_view::npos);
+}
+
+TEST_CASE("find character")
+{
+	const std::vector<string_view> segments{"foo", "|", "bar|baz"};
+	const segmented_view v{segments};
+	CHECK(v.find('|') == 3u);
+	CHECK(v.find('|', 4) == 7u);
+	CHECK(v.find('|', 8) == segmented_view::npos);
+	CHECK(v.find_first_of("rz") == 6u);
+	CHECK(v.find_first_of("z|", 4) == 7u);
+	CHECK(v.find_first_of("xy") == segmented_view::npos);
+}
+TEST_SUITE_END();
+
+TEST_SUITE("stream_searcher");
+TEST_CASE("empty needle")
+{
+	CHECK_THROWS_AS(stream_searcher{""}, const std::invalid_argument &);
+}
+
+TEST_CASE("matches within one chunk")
+{
+	stream_searcher s{"fox"};
+	const auto r = s.feed("the quick brown fox jumps over the fox");
+	REQUIRE(r.size() == 2u);
+	CHECK(r[0] == 16u);
+	CHECK(r[1] == 35u);
+	CHECK(s.position() == 38u);
+}
+
+TEST_CASE("match split across chunks")
+{
+	stream_searcher s{"brown fox"};
+	CHECK(s.feed("the quick br").empty());
+	CHECK(s.partial_match() == 2u);
+	CHECK(s.feed("o").empty());
+	CHECK(s.feed("wn f").empty());
+	const auto r = s.feed("ox jumps");
+	REQUIRE(r.size() == 1u);
+	CHECK(r[0] == 10u);
+}
+
+TEST_CASE("partial match falling back")
+{
+	stream_searcher s{"abac"};
+	CHECK(s.feed("xxab").empty());
+	CHECK(s.feed("ab").empty());
+	const auto r = s.feed("acab");
+	REQUIRE(r.size() == 1u);
+	CHECK(r[0] == 4u);
+}
+
+TEST_CASE("overlapping matches")
+{
+	stream_searcher s{"aa"};
+	const auto r = s.feed("aaa");
+	REQUIRE(r.size() == 2u);
+	CHECK(r[0] == 0u);
+	CHECK(r[1] == 1u);
+	const auto q = s.feed("a");
+	REQUIRE(q.size() == 1u);
+	CHECK(q[0] == 2u);
+}
+
+TEST_CASE("output iterator and reset")
+{
+	stream_searcher s{"ab"};
+	std::vector<std::size_t> r;
+	s.feed("xa", std::back_inserter(r));
+	s.reset();
+	s.feed("b ab", std::back_inserter(r));
+	REQUIRE(r.size() == 1u);
+	CHECK(r[0] == 2u);
+}
+TEST_SUITE_END();
+
+TEST_SUITE("line_reader");
+TEST_CASE("read lines")
+{
+	temporary_file tmp{"Hello\nWorld\n\nfoo"};
+	const int fd = ::open(tmp.path.c_str(), O_RDONLY);
+	REQUIRE(fd >= 0);
+	line_reader r{fd};
+	string_view line;
+	REQUIRE(r.next(line));
+	CHECK(line == "Hello");
+	REQUIRE(r.next(line));
+	CHECK(line == "World");
+	REQUIRE(r.next(line));
+	CHECK(line == "");
+	REQUIRE(r.next(line));
+	CHECK(line == "foo");
+	CHECK_FALSE(r.next(line));
+	CHECK(r.eof());
+	::close(fd);
+}
+
+TEST_CASE("read empty input")
+{
+	temporary_file tmp;
+	const int fd = ::open(tmp.path.c_str(), O_RDONLY);
+	REQUIRE(fd >= 0);
+	line_reader r{fd};
+	string_view line;
+	CHECK_FALSE(r.next(line));
+	::close(fd);
+}
+
+TEST_CASE("lines spanning refills and longer than the buffer")
+{
+	std::string content;
+	for (int i = 0; i < 100; ++i)
+		content += std::string(static_cast<std::size_t>(i % 23), 'a' + (i % 26)) + '\n';
+	content += std::string(50, 'z') + '\n';
+	temporary_file tmp{content};
+	const int fd = ::open(tmp.path.c_str(), O_RDONLY);
+	REQUIRE(fd >= 0);
+
+	line_reader r{fd, 16};
+	std::string result;
+	string_view line;
+	while (r.next(line)) {
+		append_to(result, line);
+		result += '\n';
+	}
+	CHECK(result == content);
+	::close(fd);
+}
+
+TEST_CASE("read from pipe")
+{
+	int fds[2];
+	REQUIRE(::pipe(fds) == 0);
+	REQUIRE(::write(fds[1], "foo\nbar\n", 8) == 8);
+	::close(fds[1]);
+
+	line_reader r{fds[0], 4};
+	string_view line;
+	REQUIRE(r.next(line));
+	CHECK(line == "foo");
+	REQUIRE(r.next(line));
+	CHECK(line == "bar");
+	CHECK_FALSE(r.next(line));
+	::close(fds[0]);
+}
+
+TEST_CASE("read error")
+{
+	line_reader r{-1};
+	string_view line;
+	CHECK_THROWS_AS(r.next(line), const std::system_error &);
+}
+TEST_SUITE_END();
+
+namespace
+{
+std::string read_all(int fd)
+{
+	std::string result;
+	char buf[256];
+	ssize_t n;
+	while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+		result.append(buf, static_cast<std::size_t>(n));
+	return result;
+}
+}
+
+TEST_SUITE("gather_writer");
+TEST_CASE("small and large views")
+{
+	temporary_file tmp;
+	const int fd = ::open(tmp.path.c_str(), O_WRONLY);
+	REQUIRE(fd >= 0);
+	const std::string body(1000, 'x');
+	{
+		gather_writer w{fd, 64, 16};
+		w << "HTTP/1.1 200 OK\r\n"
+		  << "Content-Length: "
+		  << "1000"
+		  << "\r\n\r\n";
+		w.append(string_view{body});
+		CHECK(w.pending() == 17u + 16u + 4u + 4u + 1000u);
+		w.flush();
+		CHECK(w.pending() == 0u);
+		w << "" << "!";
+	}
+	::close(fd);
+
+	const int in = ::open(tmp.path.c_str(), O_RDONLY);
+	REQUIRE(in >= 0);
+	CHECK(read_all(in) == "HTTP/1.1 200 OK\r\nContent-Length: 1000\r\n\r\n" + body + "!");
+	::close(in);
+}
+
+TEST_CASE("many fragments")
+{
+	int fds[2];
+	REQUIRE(::pipe(fds) == 0);
+	std::string expected;
+	{
+		const std::string large(20, 'L');
+		gather_writer w{fds[1], 32, 8};
+		for (int i = 0; i < 3000; ++i) {
+			if (i % 7 == 0) {
+				w << string_view{large};
+				expected += large;
+			} else {
+				w << "ab";
+				expected += "ab";
+			}
+			if (i % 500 == 0)
+				w.flush(); // keep the pipe from filling up
+		}
+		w.flush();
+	}
+	::close(fds[1]);
+	CHECK(read_all(fds[0]) == expected);
+	::close(fds[0]);
+}
+
+TEST_CASE("non blocking descriptor")
+{
+	int fds[2];
+	REQUIRE(::pipe(fds) == 0);
+	REQUIRE(::fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+	REQUIRE(::fcntl(fds[1], F_SETFL, O_NONBLOCK) == 0);
+
+	// more than the capacity of the pipe, each flush writes only a part
+	const std::string a(200000u, 'A');
+	const std::string b(100000u, 'B');
+	std::string received;
+	auto drain = [&received, &fds]() {
+		char buf[4096];
+		ssize_t n;
+		while ((n = ::read(fds[0], buf, sizeof(buf))) > 0)
+			received.append(buf, static_cast<std::size_t>(n));
+	};
+	{
+		gather_writer w{fds[1]};
+		w << string_view{a} << "-" << string_view{b};
+		int errors = 0;
+		for (int i = 0; (i < 1000) && (w.pending() > 0u); ++i) {
+			const auto pending = w.pending();
+			try {
+				w.flush();
+			} catch (const std::system_error & e) {
+				CHECK(((e.code().value() == EAGAIN) || (e.code().value() == EWOULDBLOCK)));
+				++errors;
+			}
+			CHECK(w.pending() <= pending);
+			CHECK(w.pending() + received.size() <= a.size() + b.size() + 1u);
+			drain();
+		}
+		CHECK(errors > 0);
+		CHECK(w.pending() == 0u);
+	}
+	drain();
+	::close(fds[0]);
+	::close(fds[1]);
+	CHECK(received.size() == a.size() + b.size() + 1u);
+	CHECK(received == a + "-" + b);
+}
+
+TEST_CASE("write error")
+{
+	gather_writer w{-1};
+	w << "foo";
+	CHECK_THROWS_AS(w.flush(), const std::system_error &);
+}
 TEST_SUITE_END();
 
+namespace
+{
+/// Reassembles the scanned files from the delivered blocks.
+std::vector<std::string> scan_files(
+	file_scanner & scanner, const std::vector<std::string> & paths)
+{
+	std::vector<std::string> result(paths.size());
+	scanner.scan(paths, [&result](const file_scanner::block & b) {
+		std::string & s = result[b.file];
+		if (s.size() < b.offset + b.data.size())
+			s.resize(b.offset + b.data.size());
+		b.data.copy(&s[b.offset], b.data.size());
+	});
+	return result;
+}
+
+void check_scanner(file_scanner & scanner)
+{
+	std::string large;
+	for (int i = 0; i < 1000; ++i)
+		large += "line " + std::to_string(i) + '\n';
+	temporary_file a{large};
+	temporary_file b;
+	temporary_file c{"Hello World"};
+
+	const auto result = scan_files(scanner, {a.path, b.path, c.path});
+	REQUIRE(result.size() == 3u);
+	CHECK(result[0] == large);
+	CHECK(result[1].empty());
+	CHECK(result[2] == "Hello World");
+}
+}
+
+TEST_SUITE("file_scanner");
+TEST_CASE("scan with automatic engine")
+{
+	file_scanner scanner{100, 4};
+	check_scanner(scanner);
+}
+
+TEST_CASE("scan with pread")
+{
+	file_scanner scanner{100, 4, file_scanner::engine::pread};
+	CHECK_FALSE(scanner.uses_io_uring());
+	check_scanner(scanner);
+}
+
+TEST_CASE("scan with io_uring")
+{
+	std::unique_ptr<file_scanner> scanner;
+	try {
+		scanner.reset(new file_scanner{64, 3, file_scanner::engine::io_uring});
+	} catch (const std::system_error &) {
+		return; // not supported by the system
+	}
+	CHECK(scanner->uses_io_uring());
+	check_scanner(*scanner);
+	check_scanner(*scanner);
+}
+
+TEST_CASE("scan file not existing")
+{
+	for (auto e : {file_scanner::engine::automatic, file_scanner::engine::pread}) {
+		file_scanner scanner{16, 2, e};
+		temporary_file a{"Hello World"};
+		CHECK_THROWS_AS(scan_files(scanner, {a.path, "/nonexistent/file"}),
+			const std::system_error &);
+		check_scanner(scanner);
+	}
+}
+
+TEST_CASE("exception from callback")
+{
+	for (auto e : {file_scanner::engine::automatic, file_scanner::engine::pread}) {
+		file_scanner scanner{4, 2, e};
+		temporary_file a{"the quick brown fox jumps over the lazy dog"};
+		const auto fail = [](const file_scanner::block &) { throw std::runtime_error{"x"}; };
+		CHECK_THROWS_AS(scanner.scan({a.path}, fail), const std::runtime_error &);
+		check_scanner(scanner);
+	}
+}
+TEST_SUITE_END();
+
+TEST_SUITE("char_set");
+TEST_CASE("contains")
+{
+	char_set s{",;\xff"};
+	CHECK(s.contains(','));
+	CHECK(s.contains(';'));
+	CHECK(s.contains('\xff'));
+	CHECK_FALSE(s.contains('a'));
+	CHECK_FALSE(s.contains('\0'));
+	s.insert('a');
+	CHECK(s.contains('a'));
+	s.erase(',');
+	CHECK_FALSE(s.contains(','));
+}
+
+TEST_CASE("find")
+{
+	const char_set s{",;"};
+	CHECK(s.find("foo;bar,baz") == 3u);
+	CHECK(s.find("foo;bar,baz", 4) == 7u);
+	CHECK(s.find("foo bar") == string_view::npos);
+	CHECK(s.find_not(",;x;") == 2u);
+	CHECK(s.find_not(",;") == string_view::npos);
+}
+TEST_SUITE_END();
+
+namespace
+{
+template <class Range> std::vector<std::string> fields(const Range & range)
+{
+	std::vector<std::string> result;
+	for (const auto & field : range)
+		result.push_back(to_string(field));
+	return result;
+}
+
+using strings = std::vector<std::string>;
+
+strings fields_of(const std::vector<string_view> & views)
+{
+	strings result;
+	for (const auto & v : views)
+		result.push_back(to_string(v));
+	return result;
+}
+}
+
+TEST_SUITE("split");
+TEST_CASE("split by character")
+{
+	CHECK(fields(split(string_view{"a,b,c"}, ',')) == (strings{"a", "b", "c"}));
+	CHECK(fields(split(string_view{"a,,b,"}, ',')) == (strings{"a", "", "b", ""}));
+	CHECK(fields(split(string_view{"abc"}, ',')) == (strings{"abc"}));
+	CHECK(fields(split(string_view{""}, ',')) == (strings{""}));
+}
+
+TEST_CASE("split by character skipping empty fields")
+{
+	CHECK(fields(split(string_view{",a,,b,"}, ',', empty_fields::skip)) == (strings{"a", "b"}));
+	CHECK(fields(split(string_view{",,,"}, ',', empty_fields::skip)).empty());
+	CHECK(fields(split(string_view{""}, ',', empty_fields::skip)).empty());
+}
+
+TEST_CASE("split with maximum number of splits")
+{
+	CHECK(fields(split(string_view{"a,b,c,d"}, ',', empty_fields::keep, 2))
+		== (strings{"a", "b", "c,d"}));
+	CHECK(fields(split(string_view{"a,b"}, ',', empty_fields::keep, 0)) == (strings{"a,b"}));
+	CHECK(fields(split(string_view{"a,,b,c"}, ',', empty_fields::skip, 1))
+		== (strings{"a", ",b,c"}));
+}
+
+TEST_CASE("split by string")
+{
+	CHECK(fields(split(string_view{"a, b, c"}, ", ")) == (strings{"a", "b", "c"}));
+	CHECK(fields(split(string_view{"a::::b"}, std::string{"::"})) == (strings{"a", "", "b"}));
+	CHECK(fields(split(string_view{"a,b"}, "")) == (strings{"a,b"}));
+}
+
+TEST_CASE("split by character set")
+{
+	CHECK(fields(split(string_view{"a,b;c d"}, char_set{",; "}))
+		== (strings{"a", "b", "c", "d"}));
+	CHECK(fields(split(string_view{"a, b"}, char_set{", "}, empty_fields::skip))
+		== (strings{"a", "b"}));
+}
+
+TEST_CASE("split iterators")
+{
+	const auto r = split(string_view{"foo|bar"}, '|');
+	auto i = r.begin();
+	CHECK(i != r.end());
+	CHECK(i->size() == 3u);
+	CHECK(*i++ == "foo");
+	CHECK(*i == "bar");
+	CHECK(++i == r.end());
+	CHECK(r.begin() == r.begin());
+	CHECK(std::distance(r.begin(), r.end()) == 2);
+}
+TEST_SUITE_END();
+
+TEST_SUITE("split_n");
+TEST_CASE("all fields present")
+{
+	const auto r = split_n<4>(string_view{"ts|level|module|msg"}, '|');
+	CHECK(r.count == 4u);
+	CHECK(r.fields[0] == "ts");
+	CHECK(r.fields[1] == "level");
+	CHECK(r.fields[2] == "module");
+	CHECK(r.fields[3] == "msg");
+}
+
+TEST_CASE("remainder in last field")
+{
+	const auto r = split_n<3>(string_view{"ts|level|module|msg|more"}, '|');
+	CHECK(r.count == 3u);
+	CHECK(r.fields[1] == "level");
+	CHECK(r.fields[2] == "module|msg|more");
+}
+
+TEST_CASE("fewer fields than expected")
+{
+	const auto r = split_n<4>(string_view{"ts||module"}, '|');
+	CHECK(r.count == 3u);
+	CHECK(r.fields[0] == "ts");
+	CHECK(r.fields[1] == "");
+	CHECK(r.fields[2] == "module");
+	CHECK(r.fields[3].empty());
+}
+
+TEST_CASE("single field")
+{
+	const auto r = split_n<1>(string_view{"a|b"}, '|');
+	CHECK(r.count == 1u);
+	CHECK(r.fields[0] == "a|b");
+}
+
+TEST_CASE("character set")
+{
+	const auto r = split_n<3>(string_view{"a b\tc d"}, char_set{" \t"});
+	CHECK(r.count == 3u);
+	CHECK(r.fields[0] == "a");
+	CHECK(r.fields[1] == "b");
+	CHECK(r.fields[2] == "c d");
+}
+TEST_SUITE_END();
+
+namespace
+{
+std::vector<std::uint32_t> reference_index(string_view s, const char_set & set)
+{
+	std::vector<std::uint32_t> result;
+	for (std::size_t i = 0u; i < s.size(); ++i)
+		if (set.contains(s[i]))
+			result.push_back(static_cast<std::uint32_t>(i));
+	return result;
+}
+}
+
+TEST_SUITE("structural_scanner");
+TEST_CASE("short input")
+{
+	const structural_scanner scanner{char_set{",\n"}};
+	std::uint32_t out[8];
+	const auto n = scanner.scan("a,b\nc,d", out, 8);
+	REQUIRE(n == 3u);
+	CHECK(out[0] == 1u);
+	CHECK(out[1] == 3u);
+	CHECK(out[2] == 5u);
+	CHECK(scanner.scan("", out, 8) == 0u);
+}
+
+TEST_CASE("long input matches reference")
+{
+	std::string s;
+	for (int i = 0; i < 1000; ++i)
+		s += "field" + std::to_string(i) + ((i % 10 == 9) ? "\n" : ",");
+	s += "tail\xff";
+
+	for (const char * chars : {",\n", "\xff", "0123456789,\n\"{}[]:;"}) {
+		const char_set set{chars};
+		const structural_scanner scanner{set};
+		std::vector<std::uint32_t> out(s.size());
+		const auto n = scanner.scan(s, out.data(), out.size());
+		out.resize(n);
+		CHECK(out == reference_index(s, set));
+	}
+}
+
+TEST_CASE("limited capacity")
+{
+	const std::string s(200, ',');
+	const structural_scanner scanner{char_set{","}};
+	std::uint32_t out[64];
+	std::vector<std::uint32_t> all;
+	std::size_t pos = 0u;
+	for (;;) {
+		const auto n = scanner.scan(s, out, 64, pos);
+		all.insert(all.end(), out, out + n);
+		if (n < 64u)
+			break;
+		pos = out[n - 1u] + 1u;
+	}
+	CHECK(all == reference_index(s, char_set{","}));
+}
+TEST_SUITE_END();
+
+namespace
+{
+std::vector<strings> read_csv(csv_reader & reader)
+{
+	std::vector<strings> result;
+	std::vector<string_view> fields;
+	while (reader.next(fields))
+		result.push_back(fields_of(fields));
+	return result;
+}
+}
+
+TEST_SUITE("csv_reader");
+TEST_CASE("simple records")
+{
+	csv_reader reader{"a,b,c\n1,2,3\n"};
+	const auto r = read_csv(reader);
+	REQUIRE(r.size() == 2u);
+	CHECK(r[0] == (strings{"a", "b", "c"}));
+	CHECK(r[1] == (strings{"1", "2", "3"}));
+	CHECK(reader.records() == 2u);
+}
+
+TEST_CASE("empty input and empty fields")
+{
+	csv_reader empty{""};
+	CHECK(read_csv(empty).empty());
+
+	csv_reader reader{",a,\n\nb"};
+	const auto r = read_csv(reader);
+	REQUIRE(r.size() == 3u);
+	CHECK(r[0] == (strings{"", "a", ""}));
+	CHECK(r[1] == (strings{""}));
+	CHECK(r[2] == (strings{"b"}));
+}
+
+TEST_CASE("CRLF line endings")
+{
+	csv_reader reader{"a,\"b\"\r\nc,d\r\n"};
+	const auto r = read_csv(reader);
+	REQUIRE(r.size() == 2u);
+	CHECK(r[0] == (strings{"a", "b"}));
+	CHECK(r[1] == (strings{"c", "d"}));
+}
+
+TEST_CASE("quoted fields are views into the data")
+{
+	const string_view data{"\"a,b\",\"line\nbreak\",c"};
+	csv_reader reader{data};
+	std::vector<string_view> fields;
+	REQUIRE(reader.next(fields));
+	REQUIRE(fields.size() == 3u);
+	CHECK(fields[0] == "a,b");
+	CHECK(fields[0].data() == data.data() + 1);
+	CHECK(fields[1] == "line\nbreak");
+	CHECK(fields[2] == "c");
+	CHECK_FALSE(reader.next(fields));
+	CHECK(reader.arena().size() == 0u);
+}
+
+TEST_CASE("escaped quotes are unescaped")
+{
+	csv_reader reader{"\"say \"\"hello\"\"\",\"\"\"\",\"\"\n"};
+	std::vector<string_view> fields;
+	REQUIRE(reader.next(fields));
+	REQUIRE(fields.size() == 3u);
+	CHECK(fields[0] == "say \"hello\"");
+	CHECK(fields[1] == "\"");
+	CHECK(fields[2] == "");
+	CHECK(reader.arena().size() > 0u);
+}
+
+TEST_CASE("quotes spanning blocks")
+{
+	std::string data;
+	std::vector<strings> expected;
+	for (int i = 0; i < 50; ++i) {
+		const std::string text = std::string(static_cast<std::size_t>(i), 'x') + ",\n";
+		data += std::to_string(i) + ",\"" + text + "\"\"" + text + "\"," + text;
+		expected.push_back(
+			strings{std::to_string(i), text + '"' + text, std::string(i, 'x'), ""});
+	}
+	csv_reader reader{data};
+	CHECK(read_csv(reader) == expected);
+}
+
+TEST_CASE("other delimiter and quote")
+{
+	csv_reader reader{"'a;b';c\n", ';', '\''};
+	const auto r = read_csv(reader);
+	REQUIRE(r.size() == 1u);
+	CHECK(r[0] == (strings{"a;b", "c"}));
+}
+TEST_SUITE_END();
+
+TEST_SUITE("parse_int");
+TEST_CASE("decimal")
+{
+	int i = -1;
+	const string_view s{"12345abc"};
+	const auto r = parse_int(s, i);
+	CHECK(r.ec == std::errc{});
+	CHECK(r.ptr == s.data() + 5);
+	CHECK(i == 12345);
+
+	CHECK(parse_int(string_view{"-42"}, i).ec == std::errc{});
+	CHECK(i == -42);
+	CHECK(parse_int(string_view{"0"}, i).ec == std::errc{});
+	CHECK(i == 0);
+	CHECK(parse_int(string_view{"000000000000000000000000007"}, i).ec == std::errc{});
+	CHECK(i == 7);
+}
+
+TEST_CASE("long decimal numbers")
+{
+	std::uint64_t u = 0u;
+	CHECK(parse_int(string_view{"18446744073709551615"}, u).ec == std::errc{});
+	CHECK(u == std::numeric_limits<std::uint64_t>::max());
+	CHECK(parse_int(string_view{"1234567890123456789"}, u).ec == std::errc{});
+	CHECK(u == 1234567890123456789u);
+	CHECK(parse_int(string_view{"98765432"}, u).ec == std::errc{});
+	CHECK(u == 98765432u);
+
+	std::int64_t i = 0;
+	CHECK(parse_int(string_view{"-9223372036854775808"}, i).ec == std::errc{});
+	CHECK(i == std::numeric_limits<std::int64_t>::min());
+	CHECK(parse_int(string_view{"9223372036854775807"}, i).ec == std::errc{});
+	CHECK(i == std::numeric_limits<std::int64_t>::max());
+}
+
+TEST_CASE("invalid input")
+{
+	int i = 5;
+	const string_view s{"abc"};
+	auto r = parse_int(s, i);
+	CHECK(r.ec == std::errc::invalid_argument);
+	CHECK(r.ptr == s.data());
+	CHECK(i == 5);
+
+	CHECK(parse_int(string_view{""}, i).ec == std::errc::invalid_argument);
+	CHECK(parse_int(string_view{"-"}, i).ec == std::errc::invalid_argument);
+	CHECK(parse_int(string_view{"+1"}, i).ec == std::errc::invalid_argument);
+	CHECK(parse_int(string_view{" 1"}, i).ec == std::errc::invalid_argument);
+
+	unsigned u = 3u;
+	CHECK(parse_int(string_view{"-1"}, u).ec == std::errc::invalid_argument);
+	CHECK(u == 3u);
+}
+
+TEST_CASE("out of range")
+{
+	std::uint8_t u8 = 1u;
+	const string_view s{"256x"};
+	const auto r = parse_int(s, u8);
+	CHECK(r.ec == std::errc::result_out_of_range);
+	CHECK(r.ptr == s.data() + 3);
+	CHECK(u8 == 1u);
+
+	std::int8_t i8 = 0;
+	CHECK(parse_int(string_view{"-128"}, i8).ec == std::errc{});
+	CHECK(i8 == -128);
+	CHECK(parse_int(string_view{"-129"}, i8).ec == std::errc::result_out_of_range);
+	CHECK(parse_int(string_view{"128"}, i8).ec == std::errc::result_out_of_range);
+
+	std::uint64_t u = 0u;
+	CHECK(parse_int(string_view{"18446744073709551616"}, u).ec
+		== std::errc::result_out_of_range);
+	CHECK(parse_int(string_view{"123456789012345678901234567890"}, u).ec
+		== std::errc::result_out_of_range);
+	std::int64_t i = 0;
+	CHECK(parse_int(string_view{"9223372036854775808"}, i).ec
+		== std::errc::result_out_of_range);
+}
+
+TEST_CASE("other bases")
+{
+	unsigned u = 0u;
+	CHECK(parse_int(string_view{"ff"}, u, 16).ec == std::errc{});
+	CHECK(u == 255u);
+	CHECK(parse_int(string_view{"DeadBeef"}, u, 16).ec == std::errc{});
+	CHECK(u == 0xdeadbeefu);
+	CHECK(parse_int(string_view{"1012"}, u, 2).ec == std::errc{});
+	CHECK(u == 5u);
+	CHECK(parse_int(string_view{"zz"}, u, 36).ec == std::errc{});
+	CHECK(u == 1295u);
+	int i = 0;
+	CHECK(parse_int(string_view{"-777"}, i, 8).ec == std::errc{});
+	CHECK(i == -511);
+}
+TEST_SUITE_END();
+
+TEST_SUITE("parse_double");
+
+namespace
+{
+template <class T> bool same_bits(T a, T b)
+{
+	return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+parse_result parse(const std::string & s, double & value)
+{
+	return parse_double(string_view{s}, value);
+}
+
+parse_result parse(const std::string & s, float & value)
+{
+	return parse_float(string_view{s}, value);
+}
+
+template <class T> bool parses_like(const std::string & s, T expected)
+{
+	T value{};
+	const auto r = parse(s, value);
+	if (r.ptr != s.data() + s.size())
+		return false;
+	if (std::isinf(expected))
+		return r.ec == std::errc::result_out_of_range;
+	return (r.ec == std::errc{}) && same_bits(value, expected);
+}
+
+// compares against strtod/strtof, which need a NUL terminated copy
+bool parses_like_strtod(const std::string & s)
+{
+	return parses_like(s, std::strtod(s.c_str(), nullptr))
+		&& parses_like(s, std::strtof(s.c_str(), nullptr));
+}
+}
+
+TEST_CASE("simple numbers")
+{
+	double d = 0.0;
+	const string_view s{"1.5e3,"};
+	const auto r = parse_double(s, d);
+	CHECK(r.ec == std::errc{});
+	CHECK(r.ptr == s.data() + 5);
+	CHECK(d == 1500.0);
+
+	CHECK(parses_like_strtod("0"));
+	CHECK(parses_like_strtod("-0"));
+	CHECK(parses_like_strtod("42"));
+	CHECK(parses_like_strtod("-3.25"));
+	CHECK(parses_like_strtod(".5"));
+	CHECK(parses_like_strtod("5."));
+	CHECK(parses_like_strtod("0.1"));
+	CHECK(parses_like_strtod("3.14159265358979323846"));
+	CHECK(parses_like_strtod("1E+10"));
+	CHECK(parses_like_strtod("12345678.12345678e-3"));
+
+	float f = 0.0f;
+	CHECK(parse_float(string_view{"0.1"}, f).ec == std::errc{});
+	CHECK(f == 0.1f);
+}
+
+TEST_CASE("hard cases")
+{
+	CHECK(parses_like_strtod("9007199254740993"));
+	CHECK(parses_like_strtod("2.2250738585072011e-308"));
+	CHECK(parses_like_strtod("2.2250738585072012e-308"));
+	CHECK(parses_like_strtod("4.9406564584124654e-324"));
+	CHECK(parses_like_strtod("2.4703282292062327e-324"));
+	CHECK(parses_like_strtod("2.4703282292062328e-324"));
+	CHECK(parses_like_strtod("1.7976931348623157e308"));
+	CHECK(parses_like_strtod("1e-400"));
+	CHECK(parses_like_strtod("0.000000000000000000000000000000000000000001"));
+	CHECK(parses_like_strtod("7.038531e-26"));
+	CHECK(parses_like_strtod("1.00000005960464477550"));
+	CHECK(parses_like_strtod("9007199254740992.000000000000000000001"));
+	CHECK(parses_like_strtod("9007199254740993.000000000000000000000"));
+	CHECK(parses_like_strtod("9007199254740993.000000000000000000001"));
+	CHECK(parses_like_strtod(
+		"2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593"
+		"264991818081799618989828234772285886546332835517796989819938739800539093906315035659"
+		"515570226392290858392449105184435931802849936536152500319370457678249219365623669863"
+		"658480757001585769269903706311928279558551332927834338409351978015531246597263579574"
+		"622766465272827220056374006485499977096599470454020828166226237857393450736339007967"
+		"761930577506740176324673600968951340535537458516661134223766678604162159680461914467"
+		"291840300530057530849048765391711386591646239524912623653881879636239373280423891018"
+		"672348497668235089863388587925628302755995657524455507255189313690836254779186948667"
+		"994968324049705821028513185451396213837722826145437693412532098591327667236328125"
+		"e-324"));
+}
+
+TEST_CASE("agrees with strtod on random input")
+{
+	std::uint64_t state = 88172645463325252u;
+	auto next = [&state]() {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	};
+
+	std::string failed;
+	for (int i = 0; failed.empty() && (i < 20000); ++i) {
+		std::string s;
+		if (next() & 1u)
+			s += '-';
+		const auto integer = next() % 22u;
+		for (std::uint64_t k = 0u; k < integer; ++k)
+			s += static_cast<char>('0' + (next() % 10u));
+		const auto fraction = next() % 24u;
+		if ((integer == 0u) || (fraction > 0u)) {
+			s += '.';
+			for (std::uint64_t k = 0u; k <= fraction; ++k)
+				s += static_cast<char>('0' + (next() % 10u));
+		}
+		if (next() & 1u)
+			s += 'e' + std::to_string(static_cast<int>(next() % 700u) - 350);
+		if (!parses_like_strtod(s))
+			failed = s;
+	}
+	CHECK(failed == "");
+
+	// exact doubles and the midpoints next to them
+	for (int i = 0; failed.empty() && (i < 20000); ++i) {
+		const std::uint64_t bits = next() & 0x7fefffffffffffffu;
+		double d;
+		std::memcpy(&d, &bits, sizeof(d));
+		std::ostringstream os;
+		os << std::setprecision(17) << d;
+		if (!parses_like_strtod(os.str()))
+			failed = os.str();
+		os.str("");
+		os << std::setprecision(40) << d;
+		if (!parses_like_strtod(os.str()))
+			failed = os.str();
+	}
+	CHECK(failed == "");
+}
+
+TEST_CASE("special values")
+{
+	double d = 0.0;
+	CHECK(parse_double(string_view{"inf"}, d).ec == std::errc{});
+	CHECK(d == std::numeric_limits<double>::infinity());
+	const string_view s{"-Infinity!"};
+	const auto r = parse_double(s, d);
+	CHECK(r.ec == std::errc{});
+	CHECK(r.ptr == s.data() + 9);
+	CHECK(d == -std::numeric_limits<double>::infinity());
+	CHECK(parse_double(string_view{"NaN"}, d).ec == std::errc{});
+	CHECK(d != d);
+	const string_view n{"nan(123)"};
+	CHECK(parse_double(n, d).ptr == n.data() + n.size());
+}
+
+TEST_CASE("invalid input and out of range")
+{
+	double d = 1.0;
+	const string_view s{"abc"};
+	const auto r = parse_double(s, d);
+	CHECK(r.ec == std::errc::invalid_argument);
+	CHECK(r.ptr == s.data());
+	CHECK(parse_double(string_view{""}, d).ec == std::errc::invalid_argument);
+	CHECK(parse_double(string_view{"."}, d).ec == std::errc::invalid_argument);
+	CHECK(parse_double(string_view{"-"}, d).ec == std::errc::invalid_argument);
+	CHECK(parse_double(string_view{"+1"}, d).ec == std::errc::invalid_argument);
+	CHECK(parse_double(string_view{"e5"}, d).ec == std::errc::invalid_argument);
+	CHECK(d == 1.0);
+
+	const string_view e{"2e"};
+	const auto re = parse_double(e, d);
+	CHECK(re.ec == std::errc{});
+	CHECK(re.ptr == e.data() + 1);
+	CHECK(d == 2.0);
+
+	CHECK(parse_double(string_view{"1e309"}, d).ec == std::errc::result_out_of_range);
+	CHECK(d == 2.0);
+	float f = 0.0f;
+	CHECK(parse_float(string_view{"1e39"}, f).ec == std::errc::result_out_of_range);
+	CHECK(parse_float(string_view{"3.4028234e38"}, f).ec == std::errc{});
+}
+TEST_SUITE_END();
+
+TEST_SUITE("parse_ints");
+
+TEST_CASE("column of numbers")
+{
+	const string_view in[] = {"0", "-7", "42", "1234567890123456", "-1234567890123456",
+		"12345678901234567", "9223372036854775807", "-9223372036854775808", "0007"};
+	std::int64_t out[9];
+	std::uint8_t ok[2];
+	CHECK(parse_ints(in, 9u, out, ok) == 9u);
+	CHECK(ok[0] == 0xffu);
+	CHECK(ok[1] == 0x01u);
+	CHECK(out[0] == 0);
+	CHECK(out[1] == -7);
+	CHECK(out[2] == 42);
+	CHECK(out[3] == 1234567890123456);
+	CHECK(out[4] == -1234567890123456);
+	CHECK(out[5] == 12345678901234567);
+	CHECK(out[6] == std::numeric_limits<std::int64_t>::max());
+	CHECK(out[7] == std::numeric_limits<std::int64_t>::min());
+	CHECK(out[8] == 7);
+}
+
+TEST_CASE("errors are reported in the bitmask")
+{
+	const string_view in[]
+		= {"", "-", "+1", " 1", "12a", "1.5", "9223372036854775808", "1", "x", "-12345678"};
+	std::int64_t out[10];
+	std::uint8_t ok[2];
+	CHECK(parse_ints(in, 10u, out, ok) == 2u);
+	CHECK(ok[0] == 0x80u);
+	CHECK(ok[1] == 0x02u);
+	CHECK(out[4] == 0);
+	CHECK(out[7] == 1);
+	CHECK(out[9] == -12345678);
+}
+
+TEST_CASE("agrees with parse_int")
+{
+	std::vector<std::string> tokens;
+	std::uint64_t x = 12345u;
+	for (int i = 0; i < 1000; ++i) {
+		x = (x * 6364136223846793005u) + 1442695040888963407u;
+		std::string t = std::to_string(x >> (x % 64u));
+		if (i % 3 == 0)
+			t.insert(0, "-");
+		if (i % 17 == 0)
+			t[x % t.size()] = '/';
+		tokens.push_back(t);
+	}
+	std::vector<string_view> in;
+	for (const auto & t : tokens)
+		in.push_back(string_view{t});
+
+	std::vector<std::int64_t> out(in.size());
+	std::vector<std::uint8_t> ok((in.size() + 7u) / 8u);
+	parse_ints(in.data(), in.size(), out.data(), ok.data());
+
+	std::size_t mismatches = 0u;
+	for (std::size_t i = 0u; i < in.size(); ++i) {
+		std::int64_t value = 0;
+		const auto r = parse_int(in[i], value);
+		const bool valid = (r.ec == std::errc{}) && (r.ptr == in[i].data() + in[i].size());
+		if ((valid != ((ok[i / 8u] >> (i % 8u)) & 1u)) || (valid && (value != out[i])))
+			++mismatches;
+	}
+	CHECK(mismatches == 0u);
+}
+TEST_SUITE_END();
+
+TEST_SUITE("iso8601");
+
+TEST_CASE("timestamps in UTC")
+{
+	auto r = parse_iso8601(string_view{"1970-01-01T00:00:00Z"});
+	CHECK(r.ok);
+	CHECK(r.epoch_nanos == 0);
+
+	r = parse_iso8601(string_view{"2026-10-16T12:34:56.789Z"});
+	CHECK(r.ok);
+	CHECK(r.epoch_nanos == 1792154096789000000);
+
+	CHECK(parse_iso8601(string_view{"2000-02-29 23:59:59"}).epoch_nanos
+		== 951868799000000000);
+	CHECK(parse_iso8601(string_view{"1969-12-31t23:59:59.999999999z"}).epoch_nanos == -1);
+	CHECK(parse_iso8601(string_view{"2016-12-31T23:59:60Z"}).epoch_nanos
+		== 1483228800000000000);
+}
+
+TEST_CASE("fractions and offsets")
+{
+	CHECK(parse_iso8601(string_view{"1970-01-01T00:00:00,5Z"}).epoch_nanos == 500000000);
+	CHECK(parse_iso8601(string_view{"1970-01-01T00:00:00.1234567899Z"}).epoch_nanos
+		== 123456789);
+	CHECK(parse_iso8601(string_view{"1970-01-01T01:00:00+01:00"}).epoch_nanos == 0);
+	CHECK(parse_iso8601(string_view{"1970-01-01T01:30:00+0130"}).epoch_nanos == 0);
+	CHECK(parse_iso8601(string_view{"1969-12-31T22:00:00.25-02"}).epoch_nanos == 250000000);
+}
+
+TEST_CASE("limits of the nanoseconds")
+{
+	auto r = parse_iso8601(string_view{"2262-04-11T23:47:16.854775807Z"});
+	CHECK(r.ok);
+	CHECK(r.epoch_nanos == std::numeric_limits<std::int64_t>::max());
+	r = parse_iso8601(string_view{"2262-04-11T23:47:15.999999999Z"});
+	CHECK(r.ok);
+	CHECK(r.epoch_nanos == 9223372035999999999);
+	r = parse_iso8601(string_view{"1677-09-21T00:12:43.145224192Z"});
+	CHECK(r.ok);
+	CHECK(r.epoch_nanos == std::numeric_limits<std::int64_t>::min());
+	r = parse_iso8601(string_view{"1677-09-21T00:12:44Z"});
+	CHECK(r.ok);
+	CHECK(r.epoch_nanos == -9223372036000000000);
+}
+
+TEST_CASE("invalid timestamps")
+{
+	CHECK(!parse_iso8601(string_view{""}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16T12:34"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16X12:34:56Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026/10/16T12:34:56Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-1a-16T12:34:56Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-13-16T12:34:56Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-00-16T12:34:56Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-02-29T12:34:56Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16T24:00:00Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16T12:60:00Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16T12:34:61Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16T12:34:56.Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16T12:34:56+1"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16T12:34:56+01:3"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16T12:34:56+01:"}).ok);
+	CHECK(!parse_iso8601(string_view{"2026-10-16T12:34:56Z "}).ok);
+	CHECK(!parse_iso8601(string_view{"2300-01-01T00:00:00Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"2262-04-11T23:47:16.854775808Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"1677-09-21T00:12:43.145224191Z"}).ok);
+	CHECK(!parse_iso8601(string_view{"1600-01-01T00:00:00Z"}).ok);
+}
+TEST_SUITE_END();
+
+TEST_SUITE("format");
+
+TEST_CASE("integers")
+{
+	char buf[24];
+	CHECK(format_int(buf, 0) == "0");
+	CHECK(format_int(buf, 7) == "7");
+	CHECK(format_int(buf, -42) == "-42");
+	CHECK(format_int(buf, 1234567890u) == "1234567890");
+	CHECK(format_int(buf, std::numeric_limits<std::int64_t>::min()) == "-9223372036854775808");
+	CHECK(format_int(buf, std::numeric_limits<std::uint64_t>::max()) == "18446744073709551615");
+	CHECK(format_int(buf, std::int8_t{-128}) == "-128");
+
+	// compared through pointers, doctest would print the unterminated buffer
+	const char * const first = buf;
+	const char * const last = buf + sizeof(buf);
+	const auto v = format_int(buf, 99);
+	CHECK(v.data() >= first);
+	CHECK(v.data() + v.size() == last);
+}
+
+TEST_CASE("doubles")
+{
+	char buf[24];
+	CHECK(format_double(buf, 0.0) == "0");
+	CHECK(format_double(buf, -0.0) == "-0");
+	CHECK(format_double(buf, 1.0) == "1");
+	CHECK(format_double(buf, 0.1) == "0.1");
+	CHECK(format_double(buf, -2.5) == "-2.5");
+	CHECK(format_double(buf, 0.3) == "0.3");
+	CHECK(format_double(buf, 123456.0) == "123456");
+	CHECK(format_double(buf, 0.001) == "0.001");
+	CHECK(format_double(buf, 1e-5) == "1e-05");
+	CHECK(format_double(buf, 1e21) == "1e+21");
+	CHECK(format_double(buf, 1e23) == "1e+23");
+	CHECK(format_double(buf, 1494816201077134336.0) == "1494816201077134336");
+	CHECK(format_double(buf, 9007199254740993.0) == "9007199254740992");
+	CHECK(format_double(buf, 123456789012345678901.0) == "123456789012345683968");
+	CHECK(format_double(buf, 5e-324) == "5e-324");
+	CHECK(format_double(buf, 1.7976931348623157e308) == "1.7976931348623157e+308");
+	CHECK(format_double(buf, std::numeric_limits<double>::infinity()) == "inf");
+	CHECK(format_double(buf, -std::numeric_limits<double>::infinity()) == "-inf");
+	CHECK(format_double(buf, std::numeric_limits<double>::quiet_NaN()) == "nan");
+}
+
+TEST_CASE("floats")
+{
+	char buf[16];
+	CHECK(format_float(buf, 0.1f) == "0.1");
+	CHECK(format_float(buf, 3.4028235e38f) == "3.4028235e+38");
+	CHECK(format_float(buf, 1e-45f) == "1e-45");
+	CHECK(format_float(buf, 16777216.0f) == "16777216");
+	CHECK(format_float(buf, 361193472.0f) == "361193472");
+	CHECK(format_float(buf, 1e10f) == "1e+10");
+}
+
+TEST_CASE("shortest round trip")
+{
+	std::uint64_t state = 0x9e3779b97f4a7c15u;
+	std::string failed;
+	for (int i = 0; failed.empty() && (i < 20000); ++i) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		const std::uint64_t bits = state & 0x7fefffffffffffffu;
+		double d;
+		std::memcpy(&d, &bits, sizeof(d));
+
+		char buf[24];
+		const std::string s = to_string(format_double(buf, d));
+		double back = 0.0;
+		parse_double(string_view{s}, back);
+
+		// significant digits, no precision with less of them parses back (integers
+		// in fixed notation are written with all their digits)
+		const bool integer = s.find_first_of(".e") == std::string::npos;
+		std::string digits;
+		for (char c : s.substr(0, s.find('e')))
+			if ((c != '.') && (!digits.empty() || (c != '0')))
+				digits += c;
+		digits.erase(digits.find_last_not_of('0') + 1u);
+		std::ostringstream os;
+		os << std::scientific << std::setprecision(static_cast<int>(digits.size()) - 2) << d;
+		const bool shorter = !integer && (digits.size() > 1u)
+			&& (std::strtod(os.str().c_str(), nullptr) == d);
+		if ((back != d) || shorter)
+			failed = s;
+	}
+	CHECK(failed == "");
+}
+TEST_SUITE_END();
+
+TEST_SUITE("concat");
+
+TEST_CASE("concat")
+{
+	const string_view prefix{"usr"};
+	const std::string name{"bin"};
+	const std::string s = concat(prefix, "/", name, string_view{}, "/ls");
+	CHECK(s == "usr/bin/ls");
+	CHECK(s.capacity() >= s.size());
+	CHECK(concat() == "");
+	CHECK(concat("a") == "a");
+
+	const std::wstring w = concat<wchar_t>(L"a", basic_string_view<wchar_t>{L"bc"});
+	CHECK(w == L"abc");
+}
+
+TEST_CASE("join")
+{
+	const std::vector<string_view> parts = {"a", "bb", "", "ccc"};
+	CHECK(join(parts, ", ") == "a, bb, , ccc");
+	CHECK(join(parts, string_view{}) == "abbccc");
+	CHECK(join(std::vector<string_view>{}, ",") == "");
+	CHECK(join(std::vector<std::string>{"x"}, ",") == "x");
+
+	const char * const names[] = {"one", "two"};
+	CHECK(join(names, "+") == "one+two");
+}
+
+TEST_CASE("append_join reuses the buffer")
+{
+	std::string s;
+	s.reserve(64u);
+	s = "list: ";
+	const auto capacity = s.capacity();
+	const std::vector<std::string> parts = {"a", "b", "c"};
+	append_join(s, parts, "|");
+	CHECK(s == "list: a|b|c");
+	CHECK(s.capacity() == capacity);
+	CHECK(&append_join(s, std::vector<string_view>{}, ",") == &s);
+	CHECK(s == "list: a|b|c");
+}
+TEST_SUITE_END();
+
+TEST_SUITE("string_searcher");
+
+TEST_CASE("find")
+{
+	const string_view h{"the quick brown fox jumps over the lazy dog, the end"};
+	const string_searcher the{"the"};
+	CHECK(the.find(h) == 0u);
+	CHECK(the.find(h, 1u) == 31u);
+	CHECK(the.find(h, 32u) == 45u);
+	CHECK(the.find(h, 46u) == string_view::npos);
+	CHECK(string_searcher{"g"}.find(h) == 42u);
+	CHECK(string_searcher{"end"}.find(h) == h.size() - 3u);
+	CHECK(string_searcher{"dogs"}.find(h) == string_view::npos);
+	CHECK(string_searcher{""}.find(h, 5u) == 5u);
+	CHECK(string_searcher{""}.find(h, h.size() + 1u) == string_view::npos);
+	CHECK(string_searcher{"the"}.find(string_view{"th"}) == string_view::npos);
+}
+
+TEST_CASE("agrees with string_view::find")
+{
+	std::string h;
+	std::uint32_t x = 1u;
+	for (int i = 0; i < 3000; ++i) {
+		x = (x * 1103515245u) + 12345u;
+		h += static_cast<char>('a' + ((x >> 16) % 3u));
+	}
+	const string_view hv{h};
+	std::size_t mismatches = 0u;
+	for (std::size_t len = 1u; len < 24u; ++len) {
+		const string_view needle = hv.substr(len * 97u, len);
+		const string_searcher s{needle};
+		for (std::size_t pos = 0u; pos < h.size(); pos += 7u)
+			if (s.find(hv, pos) != hv.find(needle, pos))
+				++mismatches;
+	}
+	CHECK(mismatches == 0u);
+
+	const basic_string_view<wchar_t> w{L"abcabd"};
+	CHECK(basic_string_searcher<wchar_t>{L"abd"}.find(w) == 3u);
+}
+TEST_SUITE_END();
+
+TEST_SUITE("replace_all");
+
+TEST_CASE("replace into a string")
+{
+	std::string out = ">";
+	CHECK(replace_all(string_view{"a {x} b {x}"}, "{x}", "value", out) == 2u);
+	CHECK(out == ">a value b value");
+
+	out.clear();
+	CHECK(replace_all(string_view{"aaaa"}, "aa", "b", out) == 2u);
+	CHECK(out == "bb");
+
+	out.clear();
+	CHECK(replace_all(string_view{"abc"}, "x", "y", out) == 0u);
+	CHECK(out == "abc");
+
+	out.clear();
+	CHECK(replace_all(string_view{"abc"}, "", "y", out) == 0u);
+	CHECK(out == "abc");
+
+	out.clear();
+	CHECK(replace_all(string_view{"a\r\nb\r\n"}, "\r\n", "", out) == 2u);
+	CHECK(out == "ab");
+}
+
+TEST_CASE("allocates at most once")
+{
+	const std::string src(1000u, 'x');
+	std::string out;
+	CHECK(replace_all(string_view{src}, "x", "yy", out) == 1000u);
+	CHECK(out == std::string(2000u, 'y'));
+	CHECK(out.capacity() < 2100u);
+}
+
+TEST_CASE("replace into a vector with a prepared searcher")
+{
+	const string_searcher crlf{"\r\n"};
+	std::vector<char> out;
+	CHECK(replace_all(string_view{"a\r\nb"}, crlf, "\n", out) == 1u);
+	CHECK(std::string(out.begin(), out.end()) == "a\nb");
+}
+TEST_SUITE_END();
+
+TEST_SUITE("find_all");
+
+namespace
+{
+template <class Range> std::vector<std::size_t> positions(const Range & range)
+{
+	return std::vector<std::size_t>(range.begin(), range.end());
+}
+
+using offsets = std::vector<std::size_t>;
+}
+
+TEST_CASE("non overlapping")
+{
+	const string_view h{"abcabcab"};
+	CHECK(positions(find_all(h, "ab")) == (offsets{0u, 3u, 6u}));
+	CHECK(positions(find_all(h, "x")) == offsets{});
+	CHECK(positions(find_all(string_view{"aaaaa"}, "aa")) == (offsets{0u, 2u}));
+	CHECK(positions(find_all(string_view{"ab"}, "")) == (offsets{0u, 1u, 2u}));
+	CHECK(positions(find_all(string_view{}, "a")) == offsets{});
+}
+
+TEST_CASE("overlapping")
+{
+	const string_view h{"aaaaa"};
+	CHECK(positions(find_all(h, "aa", overlapping_matches::keep)) == (offsets{0u, 1u, 2u, 3u}));
+	CHECK(positions(find_all(h, "aaaaa", overlapping_matches::keep)) == offsets{0u});
+	CHECK(positions(find_all(string_view{"abababa"}, "aba", overlapping_matches::keep))
+		== (offsets{0u, 2u, 4u}));
+}
+
+TEST_CASE("with a prepared searcher on long data")
+{
+	std::string h;
+	for (int i = 0; i < 100; ++i)
+		h += "GET /index.html\r\n";
+	const string_searcher crlf{"\r\n"};
+	std::size_t n = 0u;
+	std::size_t last = 0u;
+	for (auto pos : find_all(string_view{h}, crlf)) {
+		last = pos;
+		++n;
+	}
+	CHECK(n == 100u);
+	CHECK(last == h.size() - 2u);
+
+	const auto r = find_all(string_view{h}, crlf);
+	auto i = r.begin();
+	CHECK(*i == 15u);
+	CHECK(*i++ == 15u);
+	CHECK(*i == 32u);
+	CHECK(i != r.end());
+}
+TEST_SUITE_END();
+
+TEST_SUITE("count");
+
+TEST_CASE("characters")
+{
+	CHECK(string_view{}.count('a') == 0u);
+	CHECK(string_view{"banana"}.count('a') == 3u);
+	CHECK(string_view{"banana"}.count('x') == 0u);
+
+	// long enough for the counters to be summed up several times
+	std::string s(100000u, 'x');
+	for (std::size_t i = 0u; i < s.size(); i += 3u)
+		s[i] = '\n';
+	CHECK(string_view{s}.count('\n') == 33334u);
+	CHECK(string_view{s}.substr(1u, 64u * 63u + 5u).count('\n') == 1345u);
+	CHECK(string_view{std::string(20000u, 'a')}.count('a') == 20000u);
+
+	CHECK(basic_string_view<wchar_t>{L"abca"}.count(L'a') == 2u);
+}
+
+TEST_CASE("substrings")
+{
+	CHECK(string_view{"aaaa"}.count(string_view{"aa"}) == 2u);
+	CHECK(string_view{"abcabcab"}.count(string_view{"abc"}) == 2u);
+	CHECK(string_view{"abc"}.count(string_view{"abcd"}) == 0u);
+	CHECK(string_view{"abc"}.count(string_view{"c"}) == 1u);
+	CHECK(string_view{"abc"}.count(string_view{}) == 4u);
+
+	std::string s;
+	for (int i = 0; i < 1000; ++i)
+		s += "key=value;";
+	CHECK(string_view{s}.count(string_view{"=value;"}) == 1000u);
+	CHECK(string_view{s}.count(string_view{";k"}) == 999u);
+
+	CHECK(basic_string_view<wchar_t>{L"xyxyx"}.count(basic_string_view<wchar_t>{L"xyx"}) == 1u);
+}
+TEST_SUITE_END();
@@ -0,0 +1,333 @@
+#ifndef BACKPORT__CPP11__ZSTRING_VIEW__HPP
+#define BACKPORT__CPP11__ZSTRING_VIEW__HPP
+
+
+/// MIT License
+///
+/// Copyright (c) 2017 Mario Konrad <mario.konrad@gmx.net>
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "string_view.hpp"
+
+namespace backport
+{
+namespace cpp11
+{
+///
+/// View to a null terminated string.
+///
+/// Same as `basic_string_view`, but guarantees that the character following the
+/// viewed range is the null character. The data can therefore be passed to C APIs
+/// through `c_str()` without making a terminated copy first.
+///
+/// To keep the guarantee, only suffixes can be taken with `substr` and there is
+/// no `remove_suffix`.
+///
+template <class CharT, class Traits = std::char_traits<CharT>> class basic_zstring_view
+{
+public:
+	using view_type = basic_string_view<CharT, Traits>;
+	using traits_type = Traits;
+	using value_type = CharT;
+	using const_pointer = const CharT *;
+	using const_reference = const CharT &;
+	using size_type = std::size_t;
+	using const_iterator = typename view_type::const_iterator;
+	using iterator = const_iterator;
+	using const_reverse_iterator = typename view_type::const_reverse_iterator;
+	using reverse_iterator = const_reverse_iterator;
+
+public: // constants
+	static constexpr size_type npos = view_type::npos;
+
+public: // construction
+	/// Views an empty, null terminated, string.
+	basic_zstring_view() noexcept
+		: view_(null_string(), 0u)
+	{
+	}
+
+	basic_zstring_view(const basic_zstring_view &) noexcept = default;
+
+	/// Views the null terminated string `s`, string literals included.
+	basic_zstring_view(const CharT * s)
+		: view_(s)
+	{
+	}
+
+	/// Views `count` characters of `s`, `s[count]` must be the null character.
+	basic_zstring_view(const CharT * s, size_type count)
+		: view_(s, count)
+	{
+		assert(traits_type::eq(s[count], CharT{}));
+	}
+
+	/// Views the content of the string, which is always null terminated.
+	template <class Allocator>
+	basic_zstring_view(const std::basic_string<CharT, Traits, Allocator> & s) noexcept
+		: view_(s.c_str(), s.size())
+	{
+	}
+
+public: // assignment
+	basic_zstring_view & operator=(const basic_zstring_view &) = default;
+
+public: // conversion
+	operator view_type() const noexcept { return view_; }
+
+	const view_type & view() const noexcept { return view_; }
+
+public: // iterators
+	const_iterator begin() const { return view_.begin(); }
+
+	const_iterator cbegin() const { return view_.cbegin(); }
+
+	const_iterator end() const { return view_.end(); }
+
+	const_iterator cend() const { return view_.cend(); }
+
+	const_reverse_iterator rbegin() const { return view_.rbegin(); }
+
+	const_reverse_iterator crbegin() const { return view_.crbegin(); }
+
+	const_reverse_iterator rend() const { return view_.rend(); }
+
+	const_reverse_iterator crend() const { return view_.crend(); }
+
+public: // element access
+	constexpr const_reference operator[](size_type i) const { return view_[i]; }
+
+	const_reference at(size_type i) const { return view_.at(i); }
+
+	constexpr const_reference front() const { return view_.front(); }
+
+	constexpr const_reference back() const { return view_.back(); }
+
+	constexpr const_pointer data() const noexcept { return view_.data(); }
+
+	constexpr const_pointer c_str() const noexcept { return view_.data(); }
+
+public: // capacity
+	constexpr size_type size() const noexcept { return view_.size(); }
+
+	constexpr size_type length() const noexcept { return view_.length(); }
+
+	constexpr bool empty() const noexcept { return view_.size() == 0u; }
+
+public: // modifiers
+	void remove_prefix(size_type n) { view_.remove_prefix(n); }
+
+	void swap(basic_zstring_view & v) noexcept { view_.swap(v.view_); }
+
+public: // operations
+	/// Returns the suffix starting at `pos`, which is null terminated as well.
+	basic_zstring_view substr(size_type pos = 0) const
+	{
+		if (pos > size())
+			throw std::out_of_range{"substr"};
+		return basic_zstring_view{view_.data() + pos, size() - pos, unchecked{}};
+	}
+
+	/// Returns a view to `count` characters from `pos` on, which is not terminated.
+	view_type substr(size_type pos, size_type count) const { return view_.substr(pos, count); }
+
+	int compare(view_type v) const noexcept { return view_.compare(v); }
+
+	size_type find(view_type v, size_type pos = 0) const noexcept { return view_.find(v, pos); }
+
+	size_type find(CharT c, size_type pos = 0) const noexcept { return view_.find(c, pos); }
+
+	size_type rfind(view_type v, size_type pos = npos) const noexcept
+	{
+		return view_.rfind(v, pos);
+	}
+
+	size_type rfind(CharT c, size_type pos = npos) const noexcept
+	{
+		return view_.rfind(c, pos);
+	}
+
+private:
+	struct unchecked {
+	};
+
+	basic_zstring_view(const CharT * s, size_type count, unchecked) noexcept
+		: view_(s, count)
+	{
+	}
+
+	static const CharT * null_string() noexcept
+	{
+		static const CharT c{};
+		return &c;
+	}
+
+private:
+	view_type view_;
+};
+
+template <class CharT, class Traits>
+constexpr typename basic_zstring_view<CharT, Traits>::size_type
+	basic_zstring_view<CharT, Traits>::npos;
+
+// comparison operators, the overloads using `detail::non_deduced_view` compare against
+// everything implicitly convertible to a view, e.g. `string_view`, `std::basic_string`
+// or `const CharT *`
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator==(const basic_zstring_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a.view() == b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator!=(const basic_zstring_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a.view() != b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator<(const basic_zstring_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a.view() < b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator>(const basic_zstring_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a.view() > b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator<=(const basic_zstring_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a.view() <= b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator>=(const basic_zstring_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a.view() >= b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator==(const basic_zstring_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.view() == b;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator==(const detail::non_deduced_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a == b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator!=(const basic_zstring_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.view() != b;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator!=(const detail::non_deduced_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a != b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator<(const basic_zstring_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.view() < b;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator<(const detail::non_deduced_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a < b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator>(const basic_zstring_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.view() > b;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator>(const detail::non_deduced_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a > b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator<=(const basic_zstring_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.view() <= b;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator<=(const detail::non_deduced_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a <= b.view();
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator>=(const basic_zstring_view<CharT, Traits> & a,
+	const detail::non_deduced_view<CharT, Traits> & b) noexcept
+{
+	return a.view() >= b;
+}
+
+template <class CharT, class Traits = std::char_traits<CharT>>
+bool operator>=(const detail::non_deduced_view<CharT, Traits> & a,
+	const basic_zstring_view<CharT, Traits> & b) noexcept
+{
+	return a >= b.view();
+}
+
+// stream operators
+template <class CharT, class Traits>
+std::basic_ostream<CharT, Traits> & operator<<(
+	std::basic_ostream<CharT, Traits> & os, const basic_zstring_view<CharT, Traits> & v)
+{
+	return os << v.view();
+}
+
+// default types
+using zstring_view = basic_zstring_view<char>;
+}
+}
+
+#endif